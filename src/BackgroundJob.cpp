@@ -0,0 +1,91 @@
+#include "BackgroundJob.h"
+#include "ParquetTableModel.h"
+
+// Undefine 'signals' macro from Qt to prevent conflict with arrow headers
+#undef signals
+#include <parquet/arrow/reader.h>
+
+#include <QDebug>
+#include <QThread>
+
+std::atomic<quint64> BackgroundJob::s_nextId{1};
+
+BackgroundJob::BackgroundJob(QObject *parent)
+    : QObject(parent),
+      m_id(s_nextId++),
+      m_cancelled(false),
+      m_failed(false)
+{
+}
+
+BackgroundJob::~BackgroundJob() {
+    stopTasks();
+}
+
+void BackgroundJob::cancel() {
+    m_cancelled = true;
+}
+
+bool BackgroundJob::isCancelled() const {
+    return m_cancelled;
+}
+
+bool BackgroundJob::hasFailed() const {
+    return m_failed;
+}
+
+quint64 BackgroundJob::id() const {
+    return m_id;
+}
+
+bool BackgroundJob::isCurrent(const BackgroundJob *job, const QObject *sender) {
+    // Jobs are retired with deleteLater(), so the sender of a delivered signal is still alive
+    const BackgroundJob *source = qobject_cast<const BackgroundJob *>(sender);
+    return job && source && source->id() == job->id() && (!job->isCancelled() || job->hasFailed());
+}
+
+void BackgroundJob::retire(BackgroundJob *job) {
+    if (!job) {
+        return;
+    }
+    job->stopTasks();
+    {
+        std::lock_guard<std::mutex> lock(job->m_readersMutex);
+        job->m_readers.clear();
+    }
+    job->deleteLater();
+}
+
+void BackgroundJob::fail(const QString &message) {
+    qWarning() << metaObject()->className() << "failed:" << message;
+    // A job that was already cancelled, by the user or an earlier failure, reports nothing more
+    if (!m_cancelled.exchange(true)) {
+        m_failed = true;
+        emit failed(message);
+    }
+}
+
+void BackgroundJob::stopTasks() {
+    cancel();
+    m_pool.waitForDone();
+}
+
+parquet::arrow::FileReader *BackgroundJob::threadReader(const ParquetTableModel *model,
+                                                        ParquetTableModel::ReadMode mode) {
+    const auto key = std::make_tuple(QThread::currentThread(), model, mode);
+    {
+        std::lock_guard<std::mutex> lock(m_readersMutex);
+        auto it = m_readers.find(key);
+        if (it != m_readers.end()) {
+            return it->second.get();
+        }
+    }
+
+    // Opened outside the lock so pool threads starting together do not wait on each other
+    std::unique_ptr<parquet::arrow::FileReader> reader = model->createReader(mode);
+    if (!reader) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(m_readersMutex);
+    return (m_readers[key] = std::move(reader)).get();
+}
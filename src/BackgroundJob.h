@@ -0,0 +1,79 @@
+#ifndef BACKGROUNDJOB_H
+#define BACKGROUNDJOB_H
+
+#include "ParquetTableModel.h"
+
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+class QThread;
+namespace parquet {
+    namespace arrow {
+        class FileReader;
+    }
+}
+
+// Base of the whole-file jobs (summary, diff, decode benchmark, sample).
+// A job owns a private thread pool and reports through queued signals. Cancellation is an atomic
+// flag the tasks poll; the first failure cancels the job and is reported once.
+class BackgroundJob : public QObject {
+    Q_OBJECT
+
+public:
+    explicit BackgroundJob(QObject *parent = nullptr);
+    ~BackgroundJob() override;
+
+    virtual void start() = 0;
+    void cancel();
+    bool isCancelled() const;
+    bool hasFailed() const;
+    // Unique for the life of the process, unlike the job's address
+    quint64 id() const;
+
+    // Whether a dialog should handle a signal from job: it must come from the dialog's current job,
+    // and stop counting once that job was cancelled, except for the failure that cancelled it.
+    static bool isCurrent(const BackgroundJob *job, const QObject *sender);
+
+    // How a dialog drops a job: cancels and waits for its tasks, releases its readers, then deletes
+    // it once the signals it queued have been delivered. Until then no new job can take its
+    // address, and isCurrent() drops those signals by id.
+    static void retire(BackgroundJob *job);
+
+signals:
+    void progress(int done, int total);
+    void finished();
+    void failed(const QString &message);
+
+protected:
+    void fail(const QString &message);
+
+    // Cancels and waits for the running tasks. Derived destructors must call this first, as the
+    // tasks use their members.
+    void stopTasks();
+
+    // Reader over the model's file for the calling pool thread, created on its first task and
+    // reused by the thread's later tasks. Returns nullptr if the reader cannot be opened.
+    parquet::arrow::FileReader *threadReader(const ParquetTableModel *model,
+                                             ParquetTableModel::ReadMode mode = ParquetTableModel::ReadMode::Scan);
+
+    QThreadPool m_pool;
+
+private:
+    static std::atomic<quint64> s_nextId;
+
+    const quint64 m_id;
+    std::atomic<bool> m_cancelled;
+    std::atomic<bool> m_failed;
+
+    std::mutex m_readersMutex;
+    std::map<std::tuple<QThread *, const ParquetTableModel *, ParquetTableModel::ReadMode>,
+             std::unique_ptr<parquet::arrow::FileReader>> m_readers;
+};
+
+#endif // BACKGROUNDJOB_H
@@ -0,0 +1,322 @@
+#include "CachingRandomAccessFile.h"
+
+#include <arrow/buffer.h>
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QUrl>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <vector>
+
+// Empty file touched on every open; its modification time orders files for eviction
+static const char *LAST_USED_MARKER = ".last_used";
+
+static QString cacheRoot() {
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/ranges";
+}
+
+namespace {
+
+// Process-wide bookkeeping of the cache: the size of every cached file, when it was last used and
+// how many open CachingRandomAccessFiles use it. Built from the disk on first use and kept up to
+// date as blocks are written, so the size cap holds during long scans, not just between opens.
+class CacheIndex {
+public:
+    static CacheIndex &instance() {
+        static CacheIndex index;
+        return index;
+    }
+
+    void open(const QString &directory) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Entry &entry = m_entries[directory];
+        ++entry.openCount;
+        entry.lastUsed = QDateTime::currentDateTimeUtc();
+    }
+
+    void close(const QString &directory) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(directory);
+        if (it != m_entries.end() && it->second.openCount > 0) {
+            --it->second.openCount;
+            it->second.lastUsed = QDateTime::currentDateTimeUtc();
+        }
+    }
+
+    // Accounts for bytes about to be written to directory, evicting the least recently used files
+    // that are not open to make room. Returns false, accounting nothing, if they do not fit.
+    bool reserve(const QString &directory, qint64 bytes) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_totalSize + bytes > CachingRandomAccessFile::MAX_CACHE_SIZE) {
+            evict(CachingRandomAccessFile::MAX_CACHE_SIZE - bytes);
+        }
+        if (m_totalSize + bytes > CachingRandomAccessFile::MAX_CACHE_SIZE) {
+            return false;
+        }
+        m_entries[directory].size += bytes;
+        m_totalSize += bytes;
+        return true;
+    }
+
+    qint64 totalSize() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_totalSize;
+    }
+
+    void release(const QString &directory, qint64 bytes) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(directory);
+        if (it != m_entries.end()) {
+            it->second.size -= bytes;
+            m_totalSize -= bytes;
+        }
+    }
+
+private:
+    struct Entry {
+        qint64 size = 0;
+        QDateTime lastUsed;
+        int openCount = 0;
+    };
+
+    CacheIndex() {
+        const QFileInfoList directories = QDir(cacheRoot()).entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot);
+        for (const QFileInfo &directory : directories) {
+            Entry &entry = m_entries[directory.absoluteFilePath()];
+            QFileInfo markerInfo(directory.absoluteFilePath() + "/" + LAST_USED_MARKER);
+            entry.lastUsed = markerInfo.lastModified();
+            if (markerInfo.size() > 0) {
+                // Markers of earlier versions held the URI, credentials included; keep only the time
+                QFile marker(markerInfo.absoluteFilePath());
+                if (marker.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+                    marker.setFileTime(entry.lastUsed, QFileDevice::FileModificationTime);
+                }
+            }
+            QDirIterator it(directory.absoluteFilePath(), QDir::Files);
+            while (it.hasNext()) {
+                it.next();
+                entry.size += it.fileInfo().size();
+            }
+            m_totalSize += entry.size;
+        }
+    }
+
+    // Deletes closed files, least recently used first, until the cache is at most target bytes
+    void evict(qint64 target) {
+        std::vector<std::map<QString, Entry>::iterator> closed;
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+            if (it->second.openCount == 0) {
+                closed.push_back(it);
+            }
+        }
+        std::sort(closed.begin(), closed.end(), [](const auto &a, const auto &b) {
+            return a->second.lastUsed < b->second.lastUsed;
+        });
+        for (auto it : closed) {
+            if (m_totalSize <= target) {
+                break;
+            }
+            if (QDir(it->first).removeRecursively()) {
+                m_totalSize -= it->second.size;
+                m_entries.erase(it);
+            }
+        }
+    }
+
+    std::mutex m_mutex;
+    std::map<QString, Entry> m_entries;
+    qint64 m_totalSize = 0;
+};
+
+} // namespace
+
+std::string CachingRandomAccessFile::cacheDirectoryFor(const std::string &uri, int64_t size, int64_t modificationTime) {
+    // URIs may carry credentials (s3://KEY:SECRET@bucket/...), which must not reach the disk
+    QUrl url(QString::fromStdString(uri));
+    url.setUserInfo(QString());
+    QByteArray key = url.toEncoded() + '\n' + QByteArray::number(static_cast<qlonglong>(size))
+                     + '\n' + QByteArray::number(static_cast<qlonglong>(modificationTime));
+    QString directory = cacheRoot() + "/" + QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex();
+
+    QDir().mkpath(directory);
+    QFile marker(directory + "/" + LAST_USED_MARKER);
+    if (marker.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        marker.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    }
+    return directory.toStdString();
+}
+
+int64_t CachingRandomAccessFile::cachedBytes() {
+    return CacheIndex::instance().totalSize();
+}
+
+CachingRandomAccessFile::CachingRandomAccessFile(std::shared_ptr<arrow::io::RandomAccessFile> inner, int64_t size,
+                                                 std::string cacheDirectory)
+    : m_inner(std::move(inner)),
+      m_size(size),
+      m_cacheDirectory(std::move(cacheDirectory)),
+      m_position(0),
+      m_closed(false)
+{
+    CacheIndex::instance().open(QString::fromStdString(m_cacheDirectory));
+}
+
+CachingRandomAccessFile::~CachingRandomAccessFile() {
+    CacheIndex::instance().close(QString::fromStdString(m_cacheDirectory));
+}
+
+std::shared_ptr<arrow::io::RandomAccessFile> CachingRandomAccessFile::uncached() const {
+    return m_inner;
+}
+
+arrow::Status CachingRandomAccessFile::Close() {
+    m_closed = true;
+    return m_inner->Close();
+}
+
+bool CachingRandomAccessFile::closed() const {
+    return m_closed;
+}
+
+arrow::Result<int64_t> CachingRandomAccessFile::Tell() const {
+    return m_position.load();
+}
+
+arrow::Status CachingRandomAccessFile::Seek(int64_t position) {
+    if (position < 0) {
+        return arrow::Status::Invalid("Negative seek position");
+    }
+    m_position = position;
+    return arrow::Status::OK();
+}
+
+arrow::Result<int64_t> CachingRandomAccessFile::Read(int64_t nbytes, void *out) {
+    ARROW_ASSIGN_OR_RAISE(int64_t bytesRead, ReadAt(m_position, nbytes, out));
+    m_position += bytesRead;
+    return bytesRead;
+}
+
+arrow::Result<std::shared_ptr<arrow::Buffer>> CachingRandomAccessFile::Read(int64_t nbytes) {
+    ARROW_ASSIGN_OR_RAISE(auto buffer, ReadAt(m_position, nbytes));
+    m_position += buffer->size();
+    return buffer;
+}
+
+arrow::Result<int64_t> CachingRandomAccessFile::GetSize() {
+    return m_size;
+}
+
+std::string CachingRandomAccessFile::blockPath(int64_t block) const {
+    return m_cacheDirectory + "/" + std::to_string(block);
+}
+
+int64_t CachingRandomAccessFile::blockLength(int64_t block) const {
+    return std::min(CACHE_BLOCK_SIZE, m_size - block * CACHE_BLOCK_SIZE);
+}
+
+bool CachingRandomAccessFile::isCached(int64_t block) const {
+    // A block of the wrong size is a leftover of an interrupted write and is fetched again
+    QFileInfo info(QString::fromStdString(blockPath(block)));
+    return info.exists() && info.size() == blockLength(block);
+}
+
+void CachingRandomAccessFile::writeBlock(int64_t block, const uint8_t *data) const {
+    const QString directory = QString::fromStdString(m_cacheDirectory);
+    const QString path = QString::fromStdString(blockPath(block));
+    const qint64 length = blockLength(block);
+    if (!CacheIndex::instance().reserve(directory, length)) {
+        return; // The cache is full of files in use; the block is only returned to the caller
+    }
+
+    // QSaveFile writes to a temporary file and renames it, so readers never see partial blocks
+    const qint64 replacedSize = QFileInfo(path).size();
+    QSaveFile file(path);
+    if (file.open(QIODevice::WriteOnly) && file.write(reinterpret_cast<const char *>(data), length) == length
+        && file.commit()) {
+        CacheIndex::instance().release(directory, replacedSize);
+        return;
+    }
+    qWarning() << "Could not write cache block" << path;
+    CacheIndex::instance().release(directory, length);
+}
+
+arrow::Result<int64_t> CachingRandomAccessFile::ReadAt(int64_t position, int64_t nbytes, void *out) {
+    if (m_closed) {
+        return arrow::Status::Invalid("Operation on closed file");
+    }
+    if (position < 0 || nbytes < 0) {
+        return arrow::Status::Invalid("Invalid read range");
+    }
+    nbytes = std::min(nbytes, m_size - position);
+    if (nbytes <= 0) {
+        return 0;
+    }
+
+    uint8_t *output = static_cast<uint8_t *>(out);
+    const int64_t end = position + nbytes;
+    const int64_t lastBlock = (end - 1) / CACHE_BLOCK_SIZE;
+
+    // Copies the part of a block that overlaps the requested range
+    auto copyFromBlock = [&](int64_t block, const uint8_t *data) {
+        int64_t blockStart = block * CACHE_BLOCK_SIZE;
+        int64_t from = std::max(position, blockStart);
+        int64_t to = std::min(end, blockStart + blockLength(block));
+        std::memcpy(output + (from - position), data + (from - blockStart), static_cast<size_t>(to - from));
+    };
+
+    int64_t block = position / CACHE_BLOCK_SIZE;
+    while (block <= lastBlock) {
+        if (isCached(block)) {
+            QFile file(QString::fromStdString(blockPath(block)));
+            if (file.open(QIODevice::ReadOnly)) {
+                QByteArray data = file.readAll();
+                if (data.size() == blockLength(block)) {
+                    copyFromBlock(block, reinterpret_cast<const uint8_t *>(data.constData()));
+                    ++block;
+                    continue;
+                }
+            }
+        }
+
+        // Fetch this and all following missing blocks of the range in one request
+        int64_t runEnd = block;
+        while (runEnd < lastBlock && !isCached(runEnd + 1)) {
+            ++runEnd;
+        }
+        int64_t fetchStart = block * CACHE_BLOCK_SIZE;
+        int64_t fetchLength = runEnd * CACHE_BLOCK_SIZE + blockLength(runEnd) - fetchStart;
+        ARROW_ASSIGN_OR_RAISE(auto fetched, m_inner->ReadAt(fetchStart, fetchLength));
+        if (fetched->size() != fetchLength) {
+            return arrow::Status::IOError("Short read from remote file");
+        }
+
+        for (int64_t b = block; b <= runEnd; ++b) {
+            const uint8_t *data = fetched->data() + (b - block) * CACHE_BLOCK_SIZE;
+            copyFromBlock(b, data);
+            writeBlock(b, data);
+        }
+        block = runEnd + 1;
+    }
+
+    return nbytes;
+}
+
+arrow::Result<std::shared_ptr<arrow::Buffer>> CachingRandomAccessFile::ReadAt(int64_t position, int64_t nbytes) {
+    ARROW_ASSIGN_OR_RAISE(auto buffer, arrow::AllocateResizableBuffer(nbytes));
+    ARROW_ASSIGN_OR_RAISE(int64_t bytesRead, ReadAt(position, nbytes, buffer->mutable_data()));
+    if (bytesRead < nbytes) {
+        ARROW_RETURN_NOT_OK(buffer->Resize(bytesRead));
+    }
+    return std::shared_ptr<arrow::Buffer>(std::move(buffer));
+}
@@ -0,0 +1,65 @@
+#ifndef CACHINGRANDOMACCESSFILE_H
+#define CACHINGRANDOMACCESSFILE_H
+
+#include <arrow/io/interfaces.h>
+#include <arrow/result.h>
+#include <arrow/status.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+// Wraps a remote file and keeps the byte ranges fetched from it in a local disk cache.
+// Reads are widened to aligned CACHE_BLOCK_SIZE blocks, which doubles as read-ahead, and
+// consecutive missing blocks are fetched with a single ranged read. ReadAt is thread-safe,
+// so the Parquet reader's pre-buffering can issue coalesced ranges in parallel through it.
+// The cache is capped at MAX_CACHE_SIZE: writing a block first evicts the least recently used
+// files that are not open, and the block is not cached if that cannot make room.
+class CachingRandomAccessFile : public arrow::io::RandomAccessFile {
+public:
+    static constexpr int64_t CACHE_BLOCK_SIZE = 1 << 20; // 1 MiB
+#ifdef PARQUETPAD_MAX_CACHE_SIZE
+    static constexpr int64_t MAX_CACHE_SIZE = PARQUETPAD_MAX_CACHE_SIZE; // Small cap for the eviction tests
+#else
+    static constexpr int64_t MAX_CACHE_SIZE = int64_t(2) << 30; // 2 GiB across all files
+#endif
+
+    // Cache directory for one version of a remote file; a changed size or modification time gets a new one.
+    // Credentials in the URI are left out of the key.
+    static std::string cacheDirectoryFor(const std::string &uri, int64_t size, int64_t modificationTime);
+
+    // Bytes held by the cache across all files, as counted against MAX_CACHE_SIZE
+    static int64_t cachedBytes();
+
+    // The cache directory is in use, and safe from eviction, for the lifetime of the object
+    CachingRandomAccessFile(std::shared_ptr<arrow::io::RandomAccessFile> inner, int64_t size,
+                            std::string cacheDirectory);
+    ~CachingRandomAccessFile() override;
+
+    // The remote file without the cache, for whole-file scans that would only flush it
+    std::shared_ptr<arrow::io::RandomAccessFile> uncached() const;
+
+    arrow::Status Close() override;
+    bool closed() const override;
+    arrow::Result<int64_t> Tell() const override;
+    arrow::Status Seek(int64_t position) override;
+    arrow::Result<int64_t> Read(int64_t nbytes, void *out) override;
+    arrow::Result<std::shared_ptr<arrow::Buffer>> Read(int64_t nbytes) override;
+    arrow::Result<int64_t> ReadAt(int64_t position, int64_t nbytes, void *out) override;
+    arrow::Result<std::shared_ptr<arrow::Buffer>> ReadAt(int64_t position, int64_t nbytes) override;
+    arrow::Result<int64_t> GetSize() override;
+
+private:
+    std::string blockPath(int64_t block) const;
+    int64_t blockLength(int64_t block) const;
+    bool isCached(int64_t block) const;
+    void writeBlock(int64_t block, const uint8_t *data) const;
+
+    std::shared_ptr<arrow::io::RandomAccessFile> m_inner;
+    int64_t m_size;
+    std::string m_cacheDirectory;
+    std::atomic<int64_t> m_position;
+    std::atomic<bool> m_closed;
+};
+
+#endif // CACHINGRANDOMACCESSFILE_H
@@ -0,0 +1,170 @@
+#include "ColumnChunkTableModel.h"
+#include "FileInfoDialog.h"
+
+// Undefine 'signals' macro from Qt to prevent conflict with arrow headers
+#undef signals
+#include <arrow/util/compression.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/exception.h>
+#include <parquet/file_reader.h>
+#include <parquet/metadata.h>
+#include <parquet/page_index.h>
+#include <parquet/schema.h>
+#include <parquet/types.h>
+
+#include <QDebug>
+#include <QStringList>
+
+enum ChunkTableColumn {
+    ChunkRowGroup,
+    ChunkColumn,
+    ChunkCodec,
+    ChunkEncodings,
+    ChunkDictionaryPage,
+    ChunkCompressed,
+    ChunkUncompressed,
+    ChunkDataPages,
+    ChunkStatistics,
+    ChunkPageIndex,
+    ChunkBloomFilter,
+    ChunkTableColumnCount
+};
+
+ColumnChunkTableModel::ColumnChunkTableModel(QObject *parent)
+    : QAbstractTableModel(parent),
+      m_numColumns(0),
+      m_cachedRow(-1),
+      m_cachedIndexRowGroup(-1)
+{
+}
+
+ColumnChunkTableModel::~ColumnChunkTableModel() = default;
+
+void ColumnChunkTableModel::setFile(const std::shared_ptr<parquet::arrow::FileReader> &reader, bool remote) {
+    beginResetModel();
+    m_reader = reader;
+    m_metadata = reader ? reader->parquet_reader()->metadata() : nullptr;
+    m_numColumns = m_metadata ? m_metadata->num_columns() : 0;
+    m_pageIndexReader.reset();
+    if (reader && !remote) {
+        try {
+            m_pageIndexReader = reader->parquet_reader()->GetPageIndexReader();
+        } catch (const parquet::ParquetException &e) {
+            qWarning() << "Error reading page index:" << e.what();
+        }
+    }
+    m_cachedRow = -1;
+    m_cachedCells.clear();
+    m_cachedIndexRowGroup = -1;
+    m_cachedRowGroupIndex.reset();
+    endResetModel();
+}
+
+int ColumnChunkTableModel::rowCount(const QModelIndex &parent) const {
+    if (parent.isValid() || !m_metadata) {
+        return 0;
+    }
+    return m_metadata->num_row_groups() * m_numColumns;
+}
+
+int ColumnChunkTableModel::columnCount(const QModelIndex &parent) const {
+    if (parent.isValid()) {
+        return 0;
+    }
+    return ChunkTableColumnCount;
+}
+
+QVariant ColumnChunkTableModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || role != Qt::DisplayRole || !m_metadata) {
+        return QVariant();
+    }
+    return rowCells(index.row()).value(index.column());
+}
+
+QVariant ColumnChunkTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal) {
+        return QVariant();
+    }
+    static const QStringList headers = {"Row Group", "Column", "Codec", "Encodings", "Dictionary Page",
+                                        "Compressed", "Uncompressed", "Data Pages", "Statistics",
+                                        "Page Index", "Bloom Filter"};
+    return headers.value(section);
+}
+
+const QVector<QString> &ColumnChunkTableModel::rowCells(int row) const {
+    if (row == m_cachedRow) {
+        return m_cachedCells;
+    }
+
+    const int rowGroup = row / m_numColumns;
+    const int column = row % m_numColumns;
+    auto chunk = m_metadata->RowGroup(rowGroup)->ColumnChunk(column);
+
+    QStringList encodings;
+    for (parquet::Encoding::type encoding : chunk->encodings()) {
+        encodings.append(QString::fromStdString(parquet::EncodingToString(encoding)));
+    }
+
+    QString dictionaryPage = "-";
+    if (chunk->has_dictionary_page() && chunk->dictionary_page_offset() > 0
+        && chunk->data_page_offset() > chunk->dictionary_page_offset()) {
+        dictionaryPage = formatSize(chunk->data_page_offset() - chunk->dictionary_page_offset());
+    }
+
+    QString pageIndex = "None";
+    if (chunk->GetColumnIndexLocation().has_value() && chunk->GetOffsetIndexLocation().has_value()) {
+        pageIndex = "Column + Offset";
+    } else if (chunk->GetOffsetIndexLocation().has_value()) {
+        pageIndex = "Offset";
+    } else if (chunk->GetColumnIndexLocation().has_value()) {
+        pageIndex = "Column";
+    }
+
+    m_cachedCells = QVector<QString>(ChunkTableColumnCount);
+    m_cachedCells[ChunkRowGroup] = QString::number(rowGroup);
+    m_cachedCells[ChunkColumn] = QString::fromStdString(chunk->path_in_schema()->ToDotString());
+    m_cachedCells[ChunkCodec] = QString::fromStdString(arrow::util::Codec::GetCodecAsString(chunk->compression()));
+    m_cachedCells[ChunkEncodings] = encodings.join(", ");
+    m_cachedCells[ChunkDictionaryPage] = dictionaryPage;
+    m_cachedCells[ChunkCompressed] = formatSize(chunk->total_compressed_size());
+    m_cachedCells[ChunkUncompressed] = formatSize(chunk->total_uncompressed_size());
+    m_cachedCells[ChunkDataPages] = pageCount(rowGroup, column);
+    m_cachedCells[ChunkStatistics] = chunk->is_stats_set() ? "Yes" : "No";
+    m_cachedCells[ChunkPageIndex] = pageIndex;
+    m_cachedCells[ChunkBloomFilter] = chunk->bloom_filter_offset().has_value() ? "Yes" : "No";
+    m_cachedRow = row;
+    return m_cachedCells;
+}
+
+QString ColumnChunkTableModel::pageCount(int rowGroup, int column) const {
+    auto chunk = m_metadata->RowGroup(rowGroup)->ColumnChunk(column);
+
+    // Data page count from the page encoding stats, else from the offset index
+    std::vector<parquet::PageEncodingStats> encodingStats = chunk->encoding_stats();
+    if (!encodingStats.empty()) {
+        int count = 0;
+        for (const parquet::PageEncodingStats &stats : encodingStats) {
+            if (stats.page_type == parquet::PageType::DATA_PAGE || stats.page_type == parquet::PageType::DATA_PAGE_V2) {
+                count += stats.count;
+            }
+        }
+        return QString::number(count);
+    }
+    if (!m_pageIndexReader || !chunk->GetOffsetIndexLocation().has_value()) {
+        return "?";
+    }
+
+    try {
+        if (rowGroup != m_cachedIndexRowGroup) {
+            m_cachedRowGroupIndex = m_pageIndexReader->RowGroup(rowGroup);
+            m_cachedIndexRowGroup = rowGroup;
+        }
+        auto offsetIndex = m_cachedRowGroupIndex ? m_cachedRowGroupIndex->GetOffsetIndex(column) : nullptr;
+        if (offsetIndex) {
+            return QString::number(offsetIndex->page_locations().size());
+        }
+    } catch (const parquet::ParquetException &e) {
+        qWarning() << "Error reading offset index:" << e.what();
+    }
+    return "?";
+}
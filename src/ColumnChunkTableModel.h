@@ -0,0 +1,52 @@
+#ifndef COLUMNCHUNKTABLEMODEL_H
+#define COLUMNCHUNKTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QVector>
+#include <memory>
+
+namespace parquet {
+    class FileMetaData;
+    class PageIndexReader;
+    class RowGroupPageIndexReader;
+    namespace arrow {
+        class FileReader;
+    }
+}
+
+// One row per column chunk of a Parquet file, read straight from the footer metadata.
+// Cells are formatted on demand for the rows the view asks for, so files with many row groups and
+// columns cost nothing until scrolled to.
+class ColumnChunkTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    explicit ColumnChunkTableModel(QObject *parent = nullptr);
+    ~ColumnChunkTableModel() override;
+
+    // Shows the chunks of the reader's file, or nothing for a null reader. The offset index, a
+    // separate read, is only consulted for the page count of local files.
+    void setFile(const std::shared_ptr<parquet::arrow::FileReader> &reader, bool remote);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    const QVector<QString> &rowCells(int row) const;
+    QString pageCount(int rowGroup, int column) const;
+
+    std::shared_ptr<parquet::arrow::FileReader> m_reader;
+    std::shared_ptr<parquet::FileMetaData> m_metadata;
+    std::shared_ptr<parquet::PageIndexReader> m_pageIndexReader; // Null for remote files
+    int m_numColumns;
+
+    // The view asks for a row's cells one after another, so the last formatted row is kept
+    mutable int m_cachedRow;
+    mutable QVector<QString> m_cachedCells;
+    mutable int m_cachedIndexRowGroup;
+    mutable std::shared_ptr<parquet::RowGroupPageIndexReader> m_cachedRowGroupIndex;
+};
+
+#endif // COLUMNCHUNKTABLEMODEL_H
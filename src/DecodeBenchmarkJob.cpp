@@ -0,0 +1,120 @@
+#include "DecodeBenchmarkJob.h"
+#include "ParquetTableModel.h"
+
+// Undefine 'signals' macro from Qt to prevent conflict with arrow headers
+#undef signals
+#include <arrow/api.h>
+#include <arrow/io/caching.h>
+#include <arrow/io/interfaces.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/file_reader.h>
+#include <parquet/metadata.h>
+
+#include <QDebug>
+
+#include <chrono>
+
+DecodeBenchmarkJob::DecodeBenchmarkJob(const ParquetTableModel *model, QObject *parent)
+    : BackgroundJob(parent),
+      m_model(model),
+      m_numRowGroups(model->getNumRowGroups()),
+      m_numFields(model->getSchema() ? model->getSchema()->num_fields() : 0),
+      m_rowGroupsDone(0),
+      m_results(m_numFields)
+{
+    for (int field = 0; field < m_numFields; ++field) {
+        m_fieldColumns.push_back(model->columnIndicesForField(field));
+    }
+}
+
+DecodeBenchmarkJob::~DecodeBenchmarkJob() {
+    stopTasks();
+}
+
+void DecodeBenchmarkJob::start() {
+    if (m_numRowGroups == 0) {
+        emit finished();
+        return;
+    }
+
+    for (int rowGroup = 0; rowGroup < m_numRowGroups; ++rowGroup) {
+        m_pool.start([this, rowGroup]() {
+            parquet::arrow::FileReader *reader = threadReader(m_model);
+            if (!reader) {
+                fail("Could not open a reader for the Parquet file.");
+                return;
+            }
+            measureRowGroup(rowGroup, *reader);
+        });
+    }
+}
+
+QVector<ColumnDecodeStats> DecodeBenchmarkJob::results() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_results;
+}
+
+void DecodeBenchmarkJob::measureRowGroup(int rowGroup, parquet::arrow::FileReader &reader) {
+    if (isCancelled()) {
+        return;
+    }
+
+    auto rowGroupMetadata = reader.parquet_reader()->metadata()->RowGroup(rowGroup);
+    std::vector<int> allColumns;
+    for (int column = 0; column < rowGroupMetadata->num_columns(); ++column) {
+        allColumns.push_back(column);
+    }
+
+    // Fetch the whole row group into memory so that only decoding is timed
+    try {
+        reader.parquet_reader()->PreBuffer({rowGroup}, allColumns, arrow::io::IOContext(),
+                                           arrow::io::CacheOptions::Defaults());
+    } catch (const std::exception &e) {
+        fail(QString("Failed to read row group %1: %2").arg(rowGroup).arg(e.what()));
+        return;
+    }
+    arrow::Status buffered = reader.parquet_reader()->WhenBuffered({rowGroup}, allColumns).status();
+    if (!buffered.ok()) {
+        fail(QString("Failed to read row group %1: %2").arg(rowGroup).arg(buffered.ToString().c_str()));
+        return;
+    }
+
+    std::shared_ptr<parquet::arrow::RowGroupReader> rowGroupReader = reader.RowGroup(rowGroup);
+    QVector<ColumnDecodeStats> partial(m_numFields);
+    for (int field = 0; field < m_numFields; ++field) {
+        if (isCancelled()) {
+            return;
+        }
+
+        std::shared_ptr<arrow::ChunkedArray> column;
+        auto begin = std::chrono::steady_clock::now();
+        arrow::Status status = rowGroupReader->Column(field)->Read(&column);
+        auto end = std::chrono::steady_clock::now();
+        if (!status.ok()) {
+            fail(QString("Failed to decode row group %1, column %2: %3").arg(rowGroup).arg(field).arg(status.ToString().c_str()));
+            return;
+        }
+
+        ColumnDecodeStats &stats = partial[field];
+        stats.rows = rowGroupMetadata->num_rows();
+        stats.decodeSeconds = std::chrono::duration<double>(end - begin).count();
+        for (int leaf : m_fieldColumns[field]) {
+            stats.uncompressedBytes += rowGroupMetadata->ColumnChunk(leaf)->total_uncompressed_size();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (int field = 0; field < m_numFields; ++field) {
+            m_results[field].rows += partial[field].rows;
+            m_results[field].uncompressedBytes += partial[field].uncompressedBytes;
+            m_results[field].decodeSeconds += partial[field].decodeSeconds;
+        }
+    }
+
+    int done = ++m_rowGroupsDone;
+    emit progress(done, m_numRowGroups);
+    if (done == m_numRowGroups) {
+        emit finished();
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef DECODEBENCHMARKJOB_H
+#define DECODEBENCHMARKJOB_H
+
+#include "BackgroundJob.h"
+
+#include <QVector>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+class ParquetTableModel;
+namespace parquet {
+    namespace arrow {
+        class FileReader;
+    }
+}
+
+// Decode cost of one top-level column, summed over the row groups measured so far
+struct ColumnDecodeStats {
+    qint64 rows = 0;
+    qint64 uncompressedBytes = 0;
+    double decodeSeconds = 0.0;
+};
+
+// Measures how fast each column decodes.
+// Row groups are processed in parallel, one per pool thread. A row group's column chunks are
+// pre-buffered into memory first, so the timing of each column covers decompression and
+// decoding into Arrow arrays but not I/O.
+class DecodeBenchmarkJob : public BackgroundJob {
+    Q_OBJECT
+
+public:
+    DecodeBenchmarkJob(const ParquetTableModel *model, QObject *parent = nullptr);
+    ~DecodeBenchmarkJob() override;
+
+    void start() override;
+
+    // Snapshot of the statistics so far, indexed by schema field
+    QVector<ColumnDecodeStats> results() const;
+
+private:
+    void measureRowGroup(int rowGroup, parquet::arrow::FileReader &reader);
+
+    const ParquetTableModel *m_model;
+    int m_numRowGroups;
+    int m_numFields;
+    std::vector<std::vector<int>> m_fieldColumns; // Leaf column indices per field
+
+    std::atomic<int> m_rowGroupsDone;
+
+    mutable std::mutex m_mutex;
+    QVector<ColumnDecodeStats> m_results;
+};
+
+#endif // DECODEBENCHMARKJOB_H
@@ -0,0 +1,583 @@
+#include "DiffJob.h"
+#include "ParquetTableModel.h"
+
+// Undefine 'signals' macro from Qt to prevent conflict with arrow headers
+#undef signals
+#include <arrow/api.h>
+#include <arrow/io/interfaces.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/file_reader.h>
+#include <parquet/metadata.h>
+
+#include <QDebug>
+
+#include <algorithm>
+#include <cstring>
+
+// Number of differing blocks that are drilled down to individual rows
+static constexpr int MAX_RESOLVED_REGIONS = 16;
+
+// Column chunks of both files are compared in pieces of this many bytes
+static constexpr int64_t CHUNK_COMPARE_BYTES = 1 << 20;
+
+namespace {
+
+constexpr uint64_t NULL_HASH = 0x9e3779b97f4a7c15ULL;
+constexpr uint64_t MISSING_ROW_HASH = 0xc2b2ae3d27d4eb4fULL;
+
+inline uint64_t mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+uint64_t hashBytes(const uint8_t *data, size_t length) {
+    uint64_t h = mix64(length);
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        h = mix64(h ^ word);
+    }
+    if (i < length) {
+        uint64_t word = 0;
+        std::memcpy(&word, data + i, length - i);
+        h = mix64(h ^ word);
+    }
+    return h;
+}
+
+template <typename ArrayType>
+void hashBinary(const arrow::Array &array, uint64_t *out) {
+    const auto &binary = static_cast<const ArrayType &>(array);
+    for (int64_t i = 0; i < binary.length(); ++i) {
+        if (binary.IsNull(i)) {
+            out[i] = NULL_HASH;
+            continue;
+        }
+        auto view = binary.GetView(i);
+        out[i] = hashBytes(reinterpret_cast<const uint8_t *>(view.data()), view.size());
+    }
+}
+
+void hashArray(const arrow::Array &array, uint64_t *out);
+
+// Hashes the child values of all rows in one pass, then folds each row's slice of them in order
+template <typename ArrayType>
+void hashList(const arrow::Array &array, uint64_t *out) {
+    const auto &list = static_cast<const ArrayType &>(array);
+    const int64_t length = list.length();
+    if (length == 0) {
+        return;
+    }
+    const int64_t first = list.value_offset(0);
+    const int64_t last = list.value_offset(length - 1) + list.value_length(length - 1);
+    std::vector<uint64_t> valueHashes(static_cast<size_t>(last - first));
+    hashArray(*list.values()->Slice(first, last - first), valueHashes.data());
+
+    for (int64_t i = 0; i < length; ++i) {
+        if (list.IsNull(i)) {
+            out[i] = NULL_HASH;
+            continue;
+        }
+        const int64_t begin = list.value_offset(i) - first;
+        const int64_t end = begin + list.value_length(i);
+        uint64_t h = mix64(static_cast<uint64_t>(end - begin));
+        for (int64_t v = begin; v < end; ++v) {
+            h = mix64(h ^ valueHashes[v]);
+        }
+        out[i] = h;
+    }
+}
+
+// Writes one hash per element of the array to out
+void hashArray(const arrow::Array &array, uint64_t *out) {
+    const int64_t length = array.length();
+
+    switch (array.type_id()) {
+        case arrow::Type::NA:
+            std::fill(out, out + length, NULL_HASH);
+            return;
+        case arrow::Type::BOOL: {
+            const auto &booleans = static_cast<const arrow::BooleanArray &>(array);
+            for (int64_t i = 0; i < length; ++i) {
+                out[i] = booleans.IsNull(i) ? NULL_HASH : mix64(booleans.Value(i) ? 2 : 1);
+            }
+            return;
+        }
+        case arrow::Type::STRING:
+        case arrow::Type::BINARY:
+            hashBinary<arrow::BinaryArray>(array, out);
+            return;
+        case arrow::Type::LARGE_STRING:
+        case arrow::Type::LARGE_BINARY:
+            hashBinary<arrow::LargeBinaryArray>(array, out);
+            return;
+        case arrow::Type::STRING_VIEW:
+        case arrow::Type::BINARY_VIEW:
+            hashBinary<arrow::BinaryViewArray>(array, out);
+            return;
+        case arrow::Type::DICTIONARY: {
+            // Hash each dictionary entry once, then look the hashes up by index
+            const auto &dictionaryArray = static_cast<const arrow::DictionaryArray &>(array);
+            const auto &dictionary = dictionaryArray.dictionary();
+            std::vector<uint64_t> dictionaryHashes(static_cast<size_t>(dictionary->length()));
+            hashArray(*dictionary, dictionaryHashes.data());
+            for (int64_t i = 0; i < length; ++i) {
+                out[i] = dictionaryArray.IsNull(i) ? NULL_HASH : dictionaryHashes[dictionaryArray.GetValueIndex(i)];
+            }
+            return;
+        }
+        case arrow::Type::LIST:
+            hashList<arrow::ListArray>(array, out);
+            return;
+        case arrow::Type::MAP:
+            hashList<arrow::MapArray>(array, out);
+            return;
+        case arrow::Type::LARGE_LIST:
+            hashList<arrow::LargeListArray>(array, out);
+            return;
+        case arrow::Type::FIXED_SIZE_LIST:
+            hashList<arrow::FixedSizeListArray>(array, out);
+            return;
+        case arrow::Type::STRUCT: {
+            // Fields are hashed column-wise and folded into each row in field order
+            const auto &structArray = static_cast<const arrow::StructArray &>(array);
+            std::fill(out, out + length, mix64(static_cast<uint64_t>(structArray.num_fields())));
+            std::vector<uint64_t> fieldHashes(static_cast<size_t>(length));
+            for (int f = 0; f < structArray.num_fields(); ++f) {
+                hashArray(*structArray.field(f), fieldHashes.data());
+                for (int64_t i = 0; i < length; ++i) {
+                    out[i] = mix64(out[i] ^ fieldHashes[i]);
+                }
+            }
+            for (int64_t i = 0; i < length; ++i) {
+                if (structArray.IsNull(i)) {
+                    out[i] = NULL_HASH;
+                }
+            }
+            return;
+        }
+        default:
+            break;
+    }
+
+    // Fixed-width values (integers, floats, temporals, decimals, fixed size binary) are hashed as raw bytes
+    const auto *fixedWidth = dynamic_cast<const arrow::FixedWidthType *>(array.type().get());
+    if (fixedWidth && fixedWidth->bit_width() % 8 == 0 && array.data()->buffers.size() > 1) {
+        const int byteWidth = fixedWidth->bit_width() / 8;
+        const uint8_t *values = array.data()->buffers[1]->data() + array.offset() * byteWidth;
+        for (int64_t i = 0; i < length; ++i) {
+            out[i] = array.IsNull(i) ? NULL_HASH : hashBytes(values + i * byteWidth, byteWidth);
+        }
+        return;
+    }
+
+    // Remaining types (unions, run-end encoded, ...) fall back to their string form
+    for (int64_t i = 0; i < length; ++i) {
+        if (array.IsNull(i)) {
+            out[i] = NULL_HASH;
+            continue;
+        }
+        auto scalar = array.GetScalar(i);
+        std::string text = scalar.ok() ? (*scalar)->ToString() : std::string();
+        out[i] = hashBytes(reinterpret_cast<const uint8_t *>(text.data()), text.size());
+    }
+}
+
+// Per-row hashes of a whole column, in row order
+std::vector<uint64_t> hashColumn(const std::shared_ptr<arrow::ChunkedArray> &column) {
+    std::vector<uint64_t> hashes(static_cast<size_t>(column->length()));
+    int64_t offset = 0;
+    for (const auto &chunk : column->chunks()) {
+        hashArray(*chunk, hashes.data() + offset);
+        offset += chunk->length();
+    }
+    return hashes;
+}
+
+} // namespace
+
+DiffJob::DiffJob(const ParquetTableModel *left, const ParquetTableModel *right,
+                 const QStringList &columns, QObject *parent)
+    : BackgroundJob(parent),
+      m_columnNames(columns),
+      m_sameLayout(false),
+      m_numBlocks(0),
+      m_tasksDone(0),
+      m_tasksTotal(0),
+      m_drillingDown(false),
+      m_bytesProcessed(0),
+      m_bytesSkipped(0)
+{
+    const ParquetTableModel *models[2] = {left, right};
+    for (int s = 0; s < 2; ++s) {
+        Side &side = m_sides[s];
+        side.model = models[s];
+        auto schema = side.model->getSchema();
+        for (const QString &name : m_columnNames) {
+            std::vector<int> leaves = side.model->columnIndicesForField(schema->GetFieldIndex(name.toStdString()));
+            side.allColumnIndices.insert(side.allColumnIndices.end(), leaves.begin(), leaves.end());
+            side.columnIndices.push_back(std::move(leaves));
+        }
+
+        side.metadata = side.model->getFileReader()->parquet_reader()->metadata();
+        side.source = side.model->getScanSource();
+        qint64 offset = 0;
+        for (int i = 0; i < side.metadata->num_row_groups(); ++i) {
+            side.rowGroupOffsets.push_back(offset);
+            offset += side.metadata->RowGroup(i)->num_rows();
+        }
+        side.totalRows = offset;
+    }
+
+    m_sameLayout = m_sides[0].rowGroupOffsets == m_sides[1].rowGroupOffsets
+                   && m_sides[0].totalRows == m_sides[1].totalRows;
+
+    qint64 maxRows = std::max(m_sides[0].totalRows, m_sides[1].totalRows);
+    m_numBlocks = (maxRows + DIFF_BLOCK_ROWS - 1) / DIFF_BLOCK_ROWS;
+    for (Side &side : m_sides) {
+        side.blockHashes.assign(m_columnNames.size(), std::vector<uint64_t>(static_cast<size_t>(m_numBlocks), 0));
+    }
+}
+
+DiffJob::~DiffJob() {
+    stopTasks();
+}
+
+void DiffJob::start() {
+    // Empty row groups contribute nothing to any block, so they are not read at all
+    std::vector<Task> tasks;
+    if (m_sameLayout) {
+        for (int rowGroup = 0; rowGroup < m_sides[0].metadata->num_row_groups(); ++rowGroup) {
+            if (m_sides[0].metadata->RowGroup(rowGroup)->num_rows() > 0) {
+                tasks.push_back({-1, rowGroup});
+            }
+        }
+    } else {
+        for (int side = 0; side < 2; ++side) {
+            for (int rowGroup = 0; rowGroup < m_sides[side].metadata->num_row_groups(); ++rowGroup) {
+                if (m_sides[side].metadata->RowGroup(rowGroup)->num_rows() > 0) {
+                    tasks.push_back({side, rowGroup});
+                }
+            }
+        }
+    }
+
+    m_tasksTotal = static_cast<int>(tasks.size());
+    if (tasks.empty() || m_columnNames.isEmpty()) {
+        startDrillDown();
+        return;
+    }
+    for (const Task &task : tasks) {
+        m_pool.start([this, task]() { runTask(task); });
+    }
+}
+
+QVector<DiffRegion> DiffJob::regions() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_regions;
+}
+
+qint64 DiffJob::bytesProcessed() const {
+    return m_bytesProcessed;
+}
+
+qint64 DiffJob::bytesSkipped() const {
+    return m_bytesSkipped;
+}
+
+void DiffJob::taskDone() {
+    int done = ++m_tasksDone;
+    int total = m_tasksTotal;
+    emit progress(done, total);
+    if (done == total) {
+        if (m_drillingDown) {
+            finishDrillDown();
+        } else {
+            startDrillDown();
+        }
+    }
+}
+
+void DiffJob::runTask(const Task &task) {
+    if (isCancelled()) {
+        return;
+    }
+
+    const int numColumns = m_columnNames.size();
+    std::vector<int> sides;
+    std::vector<int> columns;
+    if (task.side >= 0) {
+        sides.push_back(task.side);
+        for (int c = 0; c < numColumns; ++c) {
+            columns.push_back(c);
+        }
+    } else {
+        // Same layout: identical chunk bytes contribute identically to both sides and can be left out
+        sides = {0, 1};
+        for (int c = 0; c < numColumns; ++c) {
+            if (!chunkBytesEqual(task.rowGroup, c)) {
+                columns.push_back(c);
+            }
+            if (isCancelled()) {
+                return;
+            }
+        }
+    }
+
+    if (!columns.empty()) {
+        for (int side : sides) {
+            parquet::arrow::FileReader *reader = threadReader(m_sides[side].model);
+            if (!reader) {
+                fail("Could not open a reader for the Parquet file.");
+                return;
+            }
+            std::vector<std::vector<uint64_t>> blockSums;
+            hashRowGroup(side, task.rowGroup, *reader, columns, blockSums);
+            if (isCancelled()) {
+                return;
+            }
+
+            qint64 firstBlock = m_sides[side].rowGroupOffsets[task.rowGroup] / DIFF_BLOCK_ROWS;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (size_t c = 0; c < columns.size(); ++c) {
+                std::vector<uint64_t> &hashes = m_sides[side].blockHashes[columns[c]];
+                for (size_t b = 0; b < blockSums[c].size(); ++b) {
+                    hashes[firstBlock + b] += blockSums[c][b];
+                }
+            }
+        }
+    }
+
+    taskDone();
+}
+
+bool DiffJob::chunkBytesEqual(int rowGroup, int column) {
+    const std::vector<int> &leftLeaves = m_sides[0].columnIndices[column];
+    const std::vector<int> &rightLeaves = m_sides[1].columnIndices[column];
+    if (leftLeaves.size() != rightLeaves.size()) {
+        return false;
+    }
+
+    qint64 columnBytes = 0;
+    for (size_t leaf = 0; leaf < leftLeaves.size(); ++leaf) {
+        std::unique_ptr<parquet::ColumnChunkMetaData> meta[2];
+        const int leafIndex[2] = {leftLeaves[leaf], rightLeaves[leaf]};
+
+        for (int side = 0; side < 2; ++side) {
+            meta[side] = m_sides[side].metadata->RowGroup(rowGroup)->ColumnChunk(leafIndex[side]);
+        }
+        // Cheap metadata checks first; only same-sized chunks with the same codec can be byte-identical
+        if (meta[0]->total_compressed_size() != meta[1]->total_compressed_size()
+            || meta[0]->compression() != meta[1]->compression()
+            || meta[0]->num_values() != meta[1]->num_values()) {
+            return false;
+        }
+
+        const int64_t size = meta[0]->total_compressed_size();
+        int64_t start[2];
+        for (int side = 0; side < 2; ++side) {
+            start[side] = meta[side]->data_page_offset();
+            if (meta[side]->has_dictionary_page() && meta[side]->dictionary_page_offset() > 0) {
+                start[side] = std::min(start[side], meta[side]->dictionary_page_offset());
+            }
+        }
+
+        // Compared piece by piece, so memory stays bounded and a difference stops the reads early
+        for (int64_t offset = 0; offset < size; offset += CHUNK_COMPARE_BYTES) {
+            if (isCancelled()) {
+                return false;
+            }
+            const int64_t length = std::min(CHUNK_COMPARE_BYTES, size - offset);
+            std::shared_ptr<arrow::Buffer> bytes[2];
+            for (int side = 0; side < 2; ++side) {
+                auto result = m_sides[side].source->ReadAt(start[side] + offset, length);
+                if (!result.ok()) {
+                    return false;
+                }
+                bytes[side] = *result;
+            }
+            if (!bytes[0]->Equals(*bytes[1])) {
+                return false;
+            }
+        }
+        columnBytes += 2 * size;
+    }
+
+    // Chunks that differ are counted once, when hashRowGroup() decodes them
+    m_bytesProcessed += columnBytes;
+    m_bytesSkipped += columnBytes;
+    return true;
+}
+
+void DiffJob::hashRowGroup(int side, int rowGroup, parquet::arrow::FileReader &reader,
+                           const std::vector<int> &columns, std::vector<std::vector<uint64_t>> &blockSums) {
+    std::vector<int> leaves;
+    for (int c : columns) {
+        const std::vector<int> &columnLeaves = m_sides[side].columnIndices[c];
+        leaves.insert(leaves.end(), columnLeaves.begin(), columnLeaves.end());
+    }
+
+    std::shared_ptr<arrow::Table> table;
+    arrow::Status status = reader.ReadRowGroup(rowGroup, leaves, &table);
+    if (!status.ok()) {
+        fail(QString("Failed to read row group %1: %2").arg(rowGroup).arg(status.ToString().c_str()));
+        return;
+    }
+
+    auto metadata = m_sides[side].metadata->RowGroup(rowGroup);
+    for (int leaf : leaves) {
+        m_bytesProcessed += metadata->ColumnChunk(leaf)->total_compressed_size();
+    }
+
+    // The blocks this row group's rows fall in, none if it has no rows
+    const qint64 firstRow = m_sides[side].rowGroupOffsets[rowGroup];
+    const qint64 numRows = table->num_rows();
+    const qint64 firstBlock = firstRow / DIFF_BLOCK_ROWS;
+    const qint64 numBlocks = numRows > 0 ? (firstRow + numRows - 1) / DIFF_BLOCK_ROWS - firstBlock + 1 : 0;
+
+    blockSums.assign(columns.size(), std::vector<uint64_t>(static_cast<size_t>(numBlocks), 0));
+    for (size_t c = 0; c < columns.size(); ++c) {
+        if (isCancelled()) {
+            return;
+        }
+        auto column = table->GetColumnByName(m_columnNames[columns[c]].toStdString());
+        std::vector<uint64_t> hashes = hashColumn(column);
+        for (size_t i = 0; i < hashes.size(); ++i) {
+            qint64 row = firstRow + static_cast<qint64>(i);
+            blockSums[c][row / DIFF_BLOCK_ROWS - firstBlock] += mix64(hashes[i] ^ mix64(static_cast<uint64_t>(row)));
+        }
+    }
+}
+
+void DiffJob::startDrillDown() {
+    if (isCancelled()) {
+        return;
+    }
+
+    const qint64 maxRows = std::max(m_sides[0].totalRows, m_sides[1].totalRows);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_regions.clear();
+        for (qint64 block = 0; block < m_numBlocks; ++block) {
+            DiffRegion region;
+            region.firstRow = block * DIFF_BLOCK_ROWS;
+            region.rowCount = std::min(DIFF_BLOCK_ROWS, maxRows - region.firstRow);
+            for (int c = 0; c < m_columnNames.size(); ++c) {
+                if (m_sides[0].blockHashes[c][block] != m_sides[1].blockHashes[c][block]) {
+                    region.columns.append(m_columnNames[c]);
+                }
+            }
+            bool rowsMissing = region.firstRow + region.rowCount > std::min(m_sides[0].totalRows, m_sides[1].totalRows);
+            if (!region.columns.isEmpty() || rowsMissing) {
+                m_regions.append(region);
+            }
+        }
+
+        const int resolved = std::min(static_cast<int>(m_regions.size()), MAX_RESOLVED_REGIONS);
+        for (int s = 0; s < 2; ++s) {
+            m_rowHashes[s].clear();
+            for (int r = 0; r < resolved; ++r) {
+                m_rowHashes[s].emplace_back(static_cast<size_t>(m_regions[r].rowCount), MISSING_ROW_HASH);
+            }
+        }
+    }
+
+    // Row groups of either file overlapping a region that gets resolved to rows
+    std::vector<Task> tasks;
+    const int resolved = static_cast<int>(m_rowHashes[0].size());
+    for (int side = 0; side < 2; ++side) {
+        const Side &s = m_sides[side];
+        for (size_t rowGroup = 0; rowGroup < s.rowGroupOffsets.size(); ++rowGroup) {
+            qint64 begin = s.rowGroupOffsets[rowGroup];
+            qint64 end = rowGroup + 1 < s.rowGroupOffsets.size() ? s.rowGroupOffsets[rowGroup + 1] : s.totalRows;
+            for (int r = 0; r < resolved; ++r) {
+                const DiffRegion &region = m_regions[r];
+                if (begin < region.firstRow + region.rowCount && region.firstRow < end) {
+                    tasks.push_back({side, static_cast<int>(rowGroup)});
+                    break;
+                }
+            }
+        }
+    }
+
+    m_drillingDown = true;
+    m_tasksDone = 0;
+    m_tasksTotal = static_cast<int>(tasks.size());
+    if (tasks.empty() || m_columnNames.isEmpty()) {
+        finishDrillDown();
+        return;
+    }
+    for (const Task &task : tasks) {
+        m_pool.start([this, task]() {
+            resolveRows(task.side, task.rowGroup);
+            if (!isCancelled()) {
+                taskDone();
+            }
+        });
+    }
+}
+
+void DiffJob::resolveRows(int side, int rowGroup) {
+    if (isCancelled()) {
+        return;
+    }
+    parquet::arrow::FileReader *reader = threadReader(m_sides[side].model);
+    if (!reader) {
+        fail("Could not open a reader for the Parquet file.");
+        return;
+    }
+
+    std::shared_ptr<arrow::Table> table;
+    arrow::Status status = reader->ReadRowGroup(rowGroup, m_sides[side].allColumnIndices, &table);
+    if (!status.ok()) {
+        fail(QString("Failed to read row group %1: %2").arg(rowGroup).arg(status.ToString().c_str()));
+        return;
+    }
+
+    // Combine the per-column hashes into one hash per row
+    std::vector<uint64_t> rowHashes(static_cast<size_t>(table->num_rows()), 0);
+    for (const QString &name : m_columnNames) {
+        std::vector<uint64_t> hashes = hashColumn(table->GetColumnByName(name.toStdString()));
+        for (size_t i = 0; i < rowHashes.size(); ++i) {
+            rowHashes[i] = mix64(rowHashes[i] ^ hashes[i]);
+        }
+    }
+
+    // Regions are disjoint and so are row groups, so every task writes its own slots
+    const qint64 firstRow = m_sides[side].rowGroupOffsets[rowGroup];
+    const qint64 endRow = firstRow + static_cast<qint64>(rowHashes.size());
+    for (size_t r = 0; r < m_rowHashes[side].size(); ++r) {
+        const DiffRegion &region = m_regions[static_cast<qsizetype>(r)];
+        qint64 begin = std::max(firstRow, region.firstRow);
+        qint64 end = std::min(endRow, region.firstRow + region.rowCount);
+        for (qint64 row = begin; row < end; ++row) {
+            m_rowHashes[side][r][row - region.firstRow] = rowHashes[row - firstRow];
+        }
+    }
+}
+
+void DiffJob::finishDrillDown() {
+    if (isCancelled()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (size_t r = 0; r < m_rowHashes[0].size(); ++r) {
+            DiffRegion &region = m_regions[static_cast<qsizetype>(r)];
+            for (qint64 i = 0; i < region.rowCount; ++i) {
+                if (m_rowHashes[0][r][i] != m_rowHashes[1][r][i]) {
+                    region.rows.append(region.firstRow + i);
+                }
+            }
+            region.rowsResolved = true;
+        }
+        m_rowHashes[0].clear();
+        m_rowHashes[1].clear();
+    }
+    emit finished();
+}
@@ -0,0 +1,102 @@
+#ifndef DIFFJOB_H
+#define DIFFJOB_H
+
+#include "BackgroundJob.h"
+
+#include <QStringList>
+#include <QVector>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class ParquetTableModel;
+namespace arrow {
+    class Table;
+    namespace io {
+        class RandomAccessFile;
+    }
+}
+namespace parquet {
+    class FileMetaData;
+    namespace arrow {
+        class FileReader;
+    }
+}
+
+// A block of rows whose data differs between the two files
+struct DiffRegion {
+    qint64 firstRow = 0;
+    qint64 rowCount = 0;
+    QStringList columns;        // Columns whose data differs within the block
+    QVector<qint64> rows;       // Exact differing rows, filled in for the first regions only
+    bool rowsResolved = false;
+};
+
+// Data comparison of two Parquet files.
+// Every compared column is hashed per block of DIFF_BLOCK_ROWS rows. A row's contribution to its
+// block hash depends on its position and value and contributions are summed, so row groups can be
+// hashed independently and in parallel, and files with different row group layouts still compare.
+// When both files share a row group layout, column chunks with identical bytes are skipped without
+// decoding. Differing blocks are then drilled down to individual rows.
+class DiffJob : public BackgroundJob {
+    Q_OBJECT
+
+public:
+    static constexpr qint64 DIFF_BLOCK_ROWS = 65536;
+
+    DiffJob(const ParquetTableModel *left, const ParquetTableModel *right,
+            const QStringList &columns, QObject *parent = nullptr);
+    ~DiffJob() override;
+
+    void start() override;
+
+    // Valid once finished() has been emitted
+    QVector<DiffRegion> regions() const;
+    qint64 bytesProcessed() const;
+    qint64 bytesSkipped() const;
+
+private:
+    struct Side {
+        const ParquetTableModel *model = nullptr;
+        std::shared_ptr<parquet::FileMetaData> metadata;
+        std::shared_ptr<arrow::io::RandomAccessFile> source;
+        std::vector<std::vector<int>> columnIndices; // Leaf columns per compared column
+        std::vector<int> allColumnIndices;
+        std::vector<qint64> rowGroupOffsets;          // First row of each row group
+        qint64 totalRows = 0;
+        std::vector<std::vector<uint64_t>> blockHashes; // [column][block]
+    };
+
+    struct Task {
+        int side = -1; // -1 compares the same row group of both files
+        int rowGroup = 0;
+    };
+
+    void runTask(const Task &task);
+    void hashRowGroup(int side, int rowGroup, parquet::arrow::FileReader &reader,
+                      const std::vector<int> &columns, std::vector<std::vector<uint64_t>> &blockSums);
+    bool chunkBytesEqual(int rowGroup, int column);
+    void startDrillDown();
+    void resolveRows(int side, int rowGroup);
+    void finishDrillDown();
+    void taskDone();
+
+    QStringList m_columnNames;
+    Side m_sides[2];
+    bool m_sameLayout;
+    qint64 m_numBlocks;
+
+    std::atomic<int> m_tasksDone;
+    std::atomic<int> m_tasksTotal;
+    std::atomic<bool> m_drillingDown;
+    std::atomic<qint64> m_bytesProcessed;
+    std::atomic<qint64> m_bytesSkipped;
+
+    mutable std::mutex m_mutex;
+    QVector<DiffRegion> m_regions;
+    std::vector<std::vector<uint64_t>> m_rowHashes[2]; // [region][row in block], drill-down only
+};
+
+#endif // DIFFJOB_H
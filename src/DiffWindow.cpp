@@ -0,0 +1,361 @@
+#include "DiffWindow.h"
+
+// Undefine 'signals' macro from Qt to prevent conflict with arrow headers
+#undef signals
+#include <arrow/api.h>
+#include <arrow/util/key_value_metadata.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/file_reader.h>
+#include <parquet/metadata.h>
+
+#include <QFileDialog>
+#include <QGridLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLocale>
+#include <QMessageBox>
+#include <QScrollBar>
+#include <QSplitter>
+#include <QVBoxLayout>
+
+#include <algorithm>
+
+// Individual rows listed per drilled-down region
+static constexpr int MAX_LISTED_ROWS = 1000;
+
+DiffWindow::DiffWindow(QWidget *parent)
+    : QDialog(parent),
+      m_leftModel(new ParquetTableModel(this)),
+      m_rightModel(new ParquetTableModel(this)),
+      m_job(nullptr) {
+    setWindowTitle("Compare Parquet Files");
+    setMinimumSize(1000, 700);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    QGridLayout *fileLayout = new QGridLayout();
+    m_leftPathEdit = new QLineEdit(this);
+    m_rightPathEdit = new QLineEdit(this);
+    QPushButton *leftBrowseButton = new QPushButton("Browse...", this);
+    QPushButton *rightBrowseButton = new QPushButton("Browse...", this);
+    connect(leftBrowseButton, &QPushButton::clicked, this, &DiffWindow::browseLeft);
+    connect(rightBrowseButton, &QPushButton::clicked, this, &DiffWindow::browseRight);
+    fileLayout->addWidget(new QLabel("Left:", this), 0, 0);
+    fileLayout->addWidget(m_leftPathEdit, 0, 1);
+    fileLayout->addWidget(leftBrowseButton, 0, 2);
+    fileLayout->addWidget(new QLabel("Right:", this), 1, 0);
+    fileLayout->addWidget(m_rightPathEdit, 1, 1);
+    fileLayout->addWidget(rightBrowseButton, 1, 2);
+    mainLayout->addLayout(fileLayout);
+
+    m_reportTextEdit = new QTextEdit(this);
+    m_reportTextEdit->setReadOnly(true);
+    m_differenceList = new QListWidget(this);
+    connect(m_differenceList, &QListWidget::currentItemChanged, this, &DiffWindow::showDifference);
+
+    QSplitter *reportSplitter = new QSplitter(Qt::Horizontal, this);
+    reportSplitter->addWidget(m_reportTextEdit);
+    reportSplitter->addWidget(m_differenceList);
+
+    m_leftTableView = new QTableView(this);
+    m_rightTableView = new QTableView(this);
+    for (QTableView *view : {m_leftTableView, m_rightTableView}) {
+        view->horizontalHeader()->setStretchLastSection(true);
+        view->setSelectionBehavior(QAbstractItemView::SelectRows);
+        view->setSelectionMode(QAbstractItemView::SingleSelection);
+        view->setAlternatingRowColors(true);
+    }
+    m_leftTableView->setModel(m_leftModel);
+    m_rightTableView->setModel(m_rightModel);
+
+    // Keep both sides scrolled to the same rows and columns
+    connect(m_leftTableView->verticalScrollBar(), &QScrollBar::valueChanged,
+            m_rightTableView->verticalScrollBar(), &QScrollBar::setValue);
+    connect(m_rightTableView->verticalScrollBar(), &QScrollBar::valueChanged,
+            m_leftTableView->verticalScrollBar(), &QScrollBar::setValue);
+    connect(m_leftTableView->horizontalScrollBar(), &QScrollBar::valueChanged,
+            m_rightTableView->horizontalScrollBar(), &QScrollBar::setValue);
+    connect(m_rightTableView->horizontalScrollBar(), &QScrollBar::valueChanged,
+            m_leftTableView->horizontalScrollBar(), &QScrollBar::setValue);
+
+    QSplitter *tableSplitter = new QSplitter(Qt::Horizontal, this);
+    tableSplitter->addWidget(m_leftTableView);
+    tableSplitter->addWidget(m_rightTableView);
+
+    QSplitter *mainSplitter = new QSplitter(Qt::Vertical, this);
+    mainSplitter->addWidget(reportSplitter);
+    mainSplitter->addWidget(tableSplitter);
+    mainSplitter->setStretchFactor(1, 2);
+    mainLayout->addWidget(mainSplitter);
+
+    m_progressBar = new QProgressBar(this);
+    mainLayout->addWidget(m_progressBar);
+    m_statusLabel = new QLabel(this);
+    mainLayout->addWidget(m_statusLabel);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    buttonLayout->addStretch();
+
+    m_compareButton = new QPushButton("Compare", this);
+    connect(m_compareButton, &QPushButton::clicked, this, &DiffWindow::compareFiles);
+    buttonLayout->addWidget(m_compareButton);
+
+    m_cancelButton = new QPushButton("Cancel", this);
+    connect(m_cancelButton, &QPushButton::clicked, this, &DiffWindow::cancelCompare);
+    buttonLayout->addWidget(m_cancelButton);
+
+    QPushButton *closeButton = new QPushButton("Close", this);
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::accept);
+    buttonLayout->addWidget(closeButton);
+
+    mainLayout->addLayout(buttonLayout);
+
+    setRunning(false);
+}
+
+DiffWindow::~DiffWindow() {
+    stopJob();
+}
+
+void DiffWindow::setLeftFile(const QString &filePath) {
+    m_leftFile = filePath;
+    m_leftPathEdit->setText(ParquetTableModel::displayPath(filePath));
+}
+
+void DiffWindow::browseLeft() {
+    QString filePath = QFileDialog::getOpenFileName(this, "Open Parquet File", QString(), "Parquet Files (*.parquet)");
+    if (!filePath.isEmpty()) {
+        m_leftPathEdit->setText(filePath);
+    }
+}
+
+void DiffWindow::browseRight() {
+    QString filePath = QFileDialog::getOpenFileName(this, "Open Parquet File", QString(), "Parquet Files (*.parquet)");
+    if (!filePath.isEmpty()) {
+        m_rightPathEdit->setText(filePath);
+    }
+}
+
+void DiffWindow::compareFiles() {
+    // The job reads through both models, so it must be gone before they are reloaded
+    stopJob();
+    m_differenceList->clear();
+    m_reportTextEdit->clear();
+    m_statusLabel->clear();
+    m_progressBar->reset();
+
+    QString leftPath = m_leftPathEdit->text().trimmed();
+    QString rightPath = m_rightPathEdit->text().trimmed();
+    if (!m_leftFile.isEmpty() && leftPath == ParquetTableModel::displayPath(m_leftFile)) {
+        leftPath = m_leftFile;
+    }
+    if (!m_leftModel->loadParquetFile(leftPath)) {
+        QMessageBox::critical(this, "Error", "Could not open Parquet file: " + ParquetTableModel::displayPath(leftPath));
+        return;
+    }
+    if (!m_rightModel->loadParquetFile(rightPath)) {
+        QMessageBox::critical(this, "Error", "Could not open Parquet file: " + ParquetTableModel::displayPath(rightPath));
+        return;
+    }
+
+    QStringList comparableColumns;
+    m_reportTextEdit->setHtml(compareMetadata(comparableColumns));
+
+    m_job = new DiffJob(m_leftModel, m_rightModel, comparableColumns, this);
+    connect(m_job, &DiffJob::progress, this, &DiffWindow::onProgress);
+    connect(m_job, &DiffJob::finished, this, &DiffWindow::onFinished);
+    connect(m_job, &DiffJob::failed, this, &DiffWindow::onFailed);
+
+    m_statusLabel->setText("Comparing data...");
+    m_elapsedTimer.start();
+    setRunning(true);
+    m_job->start();
+}
+
+void DiffWindow::cancelCompare() {
+    if (!m_job) {
+        return;
+    }
+    m_job->cancel();
+    m_statusLabel->setText("Comparison cancelled.");
+    setRunning(false);
+}
+
+void DiffWindow::onProgress(int tasksDone, int tasksTotal) {
+    if (!BackgroundJob::isCurrent(m_job, sender())) {
+        return;
+    }
+    m_progressBar->setRange(0, tasksTotal);
+    m_progressBar->setValue(tasksDone);
+}
+
+void DiffWindow::onFinished() {
+    if (!BackgroundJob::isCurrent(m_job, sender())) {
+        return;
+    }
+    setRunning(false);
+    m_progressBar->setValue(m_progressBar->maximum());
+
+    QLocale locale;
+    QVector<DiffRegion> regions = m_job->regions();
+    for (const DiffRegion &region : regions) {
+        QString columns = region.columns.isEmpty() ? QString("missing rows") : region.columns.join(", ");
+        if (!region.rowsResolved) {
+            QListWidgetItem *item = new QListWidgetItem(
+                QString("Rows %1 - %2: %3")
+                    .arg(locale.toString(region.firstRow))
+                    .arg(locale.toString(region.firstRow + region.rowCount - 1))
+                    .arg(columns),
+                m_differenceList);
+            item->setData(Qt::UserRole, region.firstRow);
+            continue;
+        }
+        for (int i = 0; i < region.rows.size() && i < MAX_LISTED_ROWS; ++i) {
+            QListWidgetItem *item = new QListWidgetItem(
+                QString("Row %1: %2").arg(locale.toString(region.rows[i])).arg(columns),
+                m_differenceList);
+            item->setData(Qt::UserRole, region.rows[i]);
+        }
+    }
+
+    double seconds = std::max(m_elapsedTimer.elapsed(), qint64(1)) / 1000.0;
+    double megabytes = m_job->bytesProcessed() / (1024.0 * 1024.0);
+    QString throughput = QString("%1 MB of column chunks compared in %2 s (%3 MB/s), %4 MB skipped as byte-identical")
+                             .arg(locale.toString(megabytes, 'f', 1))
+                             .arg(locale.toString(seconds, 'f', 2))
+                             .arg(locale.toString(megabytes / seconds, 'f', 1))
+                             .arg(locale.toString(m_job->bytesSkipped() / (1024.0 * 1024.0), 'f', 1));
+    if (regions.isEmpty()) {
+        m_statusLabel->setText("No data differences. " + throughput);
+    } else {
+        m_statusLabel->setText(QString("%1 differing blocks of %2 rows. ")
+                                   .arg(locale.toString(regions.size()))
+                                   .arg(locale.toString(DiffJob::DIFF_BLOCK_ROWS))
+                               + throughput);
+    }
+}
+
+void DiffWindow::onFailed(const QString &message) {
+    if (!BackgroundJob::isCurrent(m_job, sender())) {
+        return;
+    }
+    setRunning(false);
+    QMessageBox::critical(this, "Compare", message);
+}
+
+void DiffWindow::showDifference(QListWidgetItem *item) {
+    if (!item) {
+        return;
+    }
+    int row = static_cast<int>(item->data(Qt::UserRole).toLongLong());
+    for (QTableView *view : {m_leftTableView, m_rightTableView}) {
+        if (row < view->model()->rowCount()) {
+            view->selectRow(row);
+            view->scrollTo(view->model()->index(row, 0), QAbstractItemView::PositionAtCenter);
+        } else {
+            view->clearSelection();
+        }
+    }
+}
+
+void DiffWindow::stopJob() {
+    BackgroundJob::retire(m_job);
+    m_job = nullptr;
+}
+
+void DiffWindow::setRunning(bool running) {
+    m_compareButton->setEnabled(!running);
+    m_cancelButton->setEnabled(running);
+    m_leftPathEdit->setEnabled(!running);
+    m_rightPathEdit->setEnabled(!running);
+}
+
+QString DiffWindow::compareMetadata(QStringList &comparableColumns) const {
+    auto leftMetadata = m_leftModel->getFileReader()->parquet_reader()->metadata();
+    auto rightMetadata = m_rightModel->getFileReader()->parquet_reader()->metadata();
+    std::shared_ptr<arrow::Schema> leftSchema = m_leftModel->getSchema();
+    std::shared_ptr<arrow::Schema> rightSchema = m_rightModel->getSchema();
+
+    QString report;
+    auto compareValue = [&report](const QString &label, const QString &left, const QString &right) {
+        if (left == right) {
+            report += QString("<b>%1:</b> %2\n").arg(label, left.toHtmlEscaped());
+        } else {
+            report += QString("<b>%1:</b> <font color=\"red\">%2 vs %3</font>\n")
+                          .arg(label, left.toHtmlEscaped(), right.toHtmlEscaped());
+        }
+    };
+
+    compareValue("Total Rows", QString::number(leftMetadata->num_rows()), QString::number(rightMetadata->num_rows()));
+    compareValue("Number of Row Groups", QString::number(leftMetadata->num_row_groups()),
+                 QString::number(rightMetadata->num_row_groups()));
+    compareValue("Number of Columns", QString::number(leftSchema->num_fields()), QString::number(rightSchema->num_fields()));
+    compareValue("Created By", QString::fromStdString(leftMetadata->created_by()),
+                 QString::fromStdString(rightMetadata->created_by()));
+
+    // Schema: columns are matched by name, data is compared for those with equal types
+    report += "\n<b>Schema:</b>\n";
+    bool schemaDiffers = false;
+    for (int i = 0; i < leftSchema->num_fields(); ++i) {
+        std::shared_ptr<arrow::Field> field = leftSchema->field(i);
+        QString name = QString::fromStdString(field->name());
+        std::shared_ptr<arrow::Field> other = rightSchema->GetFieldByName(field->name());
+        if (!other) {
+            report += QString("  - %1: only in left\n").arg(name.toHtmlEscaped());
+            schemaDiffers = true;
+        } else if (!field->type()->Equals(*other->type())) {
+            report += QString("  - %1: %2 vs %3\n")
+                          .arg(name.toHtmlEscaped())
+                          .arg(QString::fromStdString(field->type()->ToString()).toHtmlEscaped())
+                          .arg(QString::fromStdString(other->type()->ToString()).toHtmlEscaped());
+            schemaDiffers = true;
+        } else if (leftSchema->GetFieldIndex(field->name()) == i && rightSchema->GetFieldIndex(field->name()) >= 0) {
+            // GetFieldIndex is -1 for duplicated names, which cannot be matched unambiguously
+            comparableColumns.append(name);
+        }
+    }
+    for (int i = 0; i < rightSchema->num_fields(); ++i) {
+        if (!leftSchema->GetFieldByName(rightSchema->field(i)->name())) {
+            report += QString("  - %1: only in right\n").arg(QString::fromStdString(rightSchema->field(i)->name()).toHtmlEscaped());
+            schemaDiffers = true;
+        }
+    }
+    if (!schemaDiffers) {
+        report += leftSchema->Equals(*rightSchema, false) ? "  Identical\n" : "  Same columns, different order\n";
+    }
+
+    // Key-value metadata
+    report += "\n<b>Key-Value Metadata:</b>\n";
+    auto leftKeyValues = leftMetadata->key_value_metadata();
+    auto rightKeyValues = rightMetadata->key_value_metadata();
+    bool keyValuesDiffer = false;
+    auto describeKeyValues = [&](const std::shared_ptr<const arrow::KeyValueMetadata> &from,
+                                 const std::shared_ptr<const arrow::KeyValueMetadata> &to,
+                                 const QString &missingLabel, bool reportChanged) {
+        if (!from) {
+            return;
+        }
+        for (int64_t i = 0; i < from->size(); ++i) {
+            int index = to ? to->FindKey(from->key(i)) : -1;
+            QString key = QString::fromStdString(from->key(i)).toHtmlEscaped();
+            if (index < 0) {
+                report += QString("  - %1: %2\n").arg(key, missingLabel);
+                keyValuesDiffer = true;
+            } else if (reportChanged && to->value(index) != from->value(i)) {
+                report += QString("  - %1: values differ\n").arg(key);
+                keyValuesDiffer = true;
+            }
+        }
+    };
+    describeKeyValues(leftKeyValues, rightKeyValues, "only in left", true);
+    describeKeyValues(rightKeyValues, leftKeyValues, "only in right", false);
+    if (!keyValuesDiffer) {
+        report += "  Identical\n";
+    }
+
+    report += QString("\n<b>Data:</b> comparing %1 of %2 columns\n")
+                  .arg(comparableColumns.size())
+                  .arg(leftSchema->num_fields());
+
+    return report.replace("\n", "<br>");
+}
@@ -0,0 +1,61 @@
+#ifndef DIFFWINDOW_H
+#define DIFFWINDOW_H
+
+#include <QDialog>
+#include <QElapsedTimer>
+#include <QLabel>
+#include <QLineEdit>
+#include <QListWidget>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QTableView>
+#include <QTextEdit>
+
+#include "DiffJob.h"
+#include "ParquetTableModel.h"
+
+class DiffWindow : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit DiffWindow(QWidget *parent = nullptr);
+    ~DiffWindow() override;
+
+    // Shows the file without its credentials; comparing still opens the full path or URI
+    void setLeftFile(const QString &filePath);
+
+private slots:
+    void browseLeft();
+    void browseRight();
+    void compareFiles();
+    void cancelCompare();
+    void onProgress(int tasksDone, int tasksTotal);
+    void onFinished();
+    void onFailed(const QString &message);
+    void showDifference(QListWidgetItem *item);
+
+private:
+    void stopJob();
+    void setRunning(bool running);
+    // Compares schema and file metadata, returning the report and the columns whose data can be compared
+    QString compareMetadata(QStringList &comparableColumns) const;
+
+    ParquetTableModel *m_leftModel;
+    ParquetTableModel *m_rightModel;
+    DiffJob *m_job;
+    QElapsedTimer m_elapsedTimer;
+
+    QString m_leftFile; // Full path or URI set by setLeftFile()
+    QLineEdit *m_leftPathEdit;
+    QLineEdit *m_rightPathEdit;
+    QPushButton *m_compareButton;
+    QPushButton *m_cancelButton;
+    QTextEdit *m_reportTextEdit;
+    QListWidget *m_differenceList;
+    QTableView *m_leftTableView;
+    QTableView *m_rightTableView;
+    QProgressBar *m_progressBar;
+    QLabel *m_statusLabel;
+};
+
+#endif // DIFFWINDOW_H
@@ -11,6 +11,9 @@ namespace arrow {
     class Schema;
 }
 
+// Formats a byte count as B, KB, MB or GB
+QString formatSize(qint64 bytes);
+
 class FileInfoDialog : public QDialog {
     Q_OBJECT
 
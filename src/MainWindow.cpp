@@ -11,13 +11,18 @@
 #include <QMessageBox>
 #include <QHeaderView>
 #include <QFileInfo>
+#include <QInputDialog>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent),
       m_tableView(new QTableView(this)),
       m_parquetTableModel(new ParquetTableModel(this)),
       m_fileInfoDialog(new FileInfoDialog(this)),
-      m_aboutDialog(new AboutDialog(this))
+      m_aboutDialog(new AboutDialog(this)),
+      m_summarizeDialog(new SummarizeDialog(this)),
+      m_diffWindow(new DiffWindow(this)),
+      m_storageLayoutDialog(new StorageLayoutDialog(this)),
+      m_sampleDialog(new SampleDialog(this))
 {
     setWindowTitle("ParquetPad");
     setMinimumSize(800, 600);
@@ -30,6 +35,7 @@ MainWindow::MainWindow(QWidget *parent)
     m_tableView->setAlternatingRowColors(true);
     m_tableView->setContextMenuPolicy(Qt::CustomContextMenu);
     connect(m_tableView, &QTableView::customContextMenuRequested, this, &MainWindow::showContextMenu);
+    connect(m_sampleDialog, &SampleDialog::sampleModeChanged, this, &MainWindow::updateWindowTitle);
 
     createMenus();
 }
@@ -44,6 +50,10 @@ void MainWindow::createMenus() {
     connect(m_openAction, &QAction::triggered, this, &MainWindow::openFileAction);
     m_fileMenu->addAction(m_openAction);
 
+    m_openUrlAction = new QAction("Open &URL...", this);
+    connect(m_openUrlAction, &QAction::triggered, this, &MainWindow::openUrlAction);
+    m_fileMenu->addAction(m_openUrlAction);
+
     m_fileInfoAction = new QAction("&File Information...", this);
     m_fileInfoAction->setDisabled(true); // Disabled until a file is loaded
     connect(m_fileInfoAction, &QAction::triggered, this, &MainWindow::showFileInfo);
@@ -56,6 +66,27 @@ void MainWindow::createMenus() {
     connect(m_exitAction, &QAction::triggered, this, &QWidget::close);
     m_fileMenu->addAction(m_exitAction);
 
+    m_toolsMenu = menuBar()->addMenu("&Tools");
+
+    m_summarizeAction = new QAction("&Summarize...", this);
+    m_summarizeAction->setDisabled(true); // Disabled until a file is loaded
+    connect(m_summarizeAction, &QAction::triggered, this, &MainWindow::showSummarizeDialog);
+    m_toolsMenu->addAction(m_summarizeAction);
+
+    m_storageLayoutAction = new QAction("Storage &Layout...", this);
+    m_storageLayoutAction->setDisabled(true); // Disabled until a file is loaded
+    connect(m_storageLayoutAction, &QAction::triggered, this, &MainWindow::showStorageLayoutDialog);
+    m_toolsMenu->addAction(m_storageLayoutAction);
+
+    m_sampleAction = new QAction("Sa&mple Mode...", this);
+    m_sampleAction->setDisabled(true); // Disabled until a file is loaded
+    connect(m_sampleAction, &QAction::triggered, this, &MainWindow::showSampleDialog);
+    m_toolsMenu->addAction(m_sampleAction);
+
+    m_compareAction = new QAction("&Compare Files...", this);
+    connect(m_compareAction, &QAction::triggered, this, &MainWindow::showDiffWindow);
+    m_toolsMenu->addAction(m_compareAction);
+
     m_helpMenu = menuBar()->addMenu("&Help");
     m_aboutAction = new QAction("&About", this);
     connect(m_aboutAction, &QAction::triggered, this, &MainWindow::showAboutDialog);
@@ -69,21 +100,54 @@ void MainWindow::openFileAction() {
     }
 }
 
+void MainWindow::openUrlAction() {
+    bool ok = false;
+    QString url = QInputDialog::getText(this, "Open URL", "Parquet file URL (e.g. s3://bucket/path/file.parquet):",
+                                        QLineEdit::Normal, QString(), &ok).trimmed();
+    if (ok && !url.isEmpty()) {
+        openFile(url);
+    }
+}
+
 void MainWindow::openFile(const QString &filePath) {
+    // The dialogs' jobs read through the model from pool threads, so they must be gone before it is reloaded
+    m_summarizeDialog->stopJob();
+    m_storageLayoutDialog->stopJob();
+    m_sampleDialog->stopJob();
+
     if (m_parquetTableModel->loadParquetFile(filePath)) {
-        setWindowTitle("ParquetPad - " + QFileInfo(filePath).fileName());
         m_fileInfoAction->setEnabled(true);
+        m_summarizeAction->setEnabled(true);
+        m_storageLayoutAction->setEnabled(true);
+        m_sampleAction->setEnabled(true);
     } else {
-        QMessageBox::critical(this, "Error", "Could not open Parquet file: " + filePath);
-        setWindowTitle("ParquetPad");
+        QMessageBox::critical(this, "Error", "Could not open Parquet file: " + ParquetTableModel::displayPath(filePath));
         m_fileInfoAction->setDisabled(true);
+        m_summarizeAction->setDisabled(true);
+        m_storageLayoutAction->setDisabled(true);
+        m_sampleAction->setDisabled(true);
     }
+    updateWindowTitle();
+    m_summarizeDialog->setTableModel(m_parquetTableModel);
+    m_storageLayoutDialog->setTableModel(m_parquetTableModel);
+    m_sampleDialog->setTableModel(m_parquetTableModel);
+}
+
+void MainWindow::updateWindowTitle() {
+    if (!m_fileInfoAction->isEnabled()) {
+        setWindowTitle("ParquetPad");
+        return;
+    }
+    QString title = "ParquetPad - " + QFileInfo(m_parquetTableModel->filePath()).fileName();
+    if (m_parquetTableModel->isSampleMode()) {
+        title += " (sample)";
+    }
+    setWindowTitle(title);
 }
 
 void MainWindow::showFileInfo() {
     if (m_parquetTableModel->getTotalRows() > 0) {
-        QFileInfo fileInfo(m_parquetTableModel->filePath());
-        qint64 fileSize = fileInfo.size();
+        qint64 fileSize = m_parquetTableModel->getFileSize();
         qint64 uncompressedSize = 0;
 
         auto fileReader = m_parquetTableModel->getFileReader();
@@ -94,7 +158,7 @@ void MainWindow::showFileInfo() {
             }
         }
 
-        m_fileInfoDialog->setFileInfo(m_parquetTableModel->filePath(),
+        m_fileInfoDialog->setFileInfo(ParquetTableModel::displayPath(m_parquetTableModel->filePath()),
                                       fileSize,
                                       uncompressedSize,
                                       m_parquetTableModel->getTotalRows(),
@@ -113,9 +177,40 @@ void MainWindow::showContextMenu(const QPoint &pos) {
 
     QMenu contextMenu(this);
     contextMenu.addAction(m_fileInfoAction);
+    contextMenu.addAction(m_summarizeAction);
+    contextMenu.addAction(m_storageLayoutAction);
+    contextMenu.addAction(m_sampleAction);
     contextMenu.exec(m_tableView->viewport()->mapToGlobal(pos));
 }
 
 void MainWindow::showAboutDialog() {
     m_aboutDialog->exec();
 }
+
+void MainWindow::showSummarizeDialog() {
+    // Non-modal, so the summary keeps filling in while the table is browsed
+    m_summarizeDialog->show();
+    m_summarizeDialog->raise();
+    m_summarizeDialog->activateWindow();
+}
+
+void MainWindow::showDiffWindow() {
+    if (m_fileInfoAction->isEnabled()) {
+        m_diffWindow->setLeftFile(m_parquetTableModel->filePath());
+    }
+    m_diffWindow->show();
+    m_diffWindow->raise();
+    m_diffWindow->activateWindow();
+}
+
+void MainWindow::showStorageLayoutDialog() {
+    m_storageLayoutDialog->show();
+    m_storageLayoutDialog->raise();
+    m_storageLayoutDialog->activateWindow();
+}
+
+void MainWindow::showSampleDialog() {
+    m_sampleDialog->show();
+    m_sampleDialog->raise();
+    m_sampleDialog->activateWindow();
+}
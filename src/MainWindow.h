@@ -10,6 +10,10 @@
 #include "ParquetTableModel.h"
 #include "FileInfoDialog.h"
 #include "AboutDialog.h"
+#include "SummarizeDialog.h"
+#include "DiffWindow.h"
+#include "StorageLayoutDialog.h"
+#include "SampleDialog.h"
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -22,9 +26,15 @@ public:
 
 private slots:
     void openFileAction();
+    void openUrlAction();
     void showFileInfo();
     void showContextMenu(const QPoint &pos);
     void showAboutDialog();
+    void showSummarizeDialog();
+    void showDiffWindow();
+    void showStorageLayoutDialog();
+    void showSampleDialog();
+    void updateWindowTitle();
 
 private:
     void createMenus();
@@ -33,12 +43,22 @@ private:
     ParquetTableModel *m_parquetTableModel;
     FileInfoDialog *m_fileInfoDialog;
     AboutDialog *m_aboutDialog;
+    SummarizeDialog *m_summarizeDialog;
+    DiffWindow *m_diffWindow;
+    StorageLayoutDialog *m_storageLayoutDialog;
+    SampleDialog *m_sampleDialog;
 
     QMenu *m_fileMenu;
+    QMenu *m_toolsMenu;
     QMenu *m_helpMenu;
     QAction *m_openAction;
+    QAction *m_openUrlAction;
     QAction *m_fileInfoAction;
     QAction *m_exitAction;
+    QAction *m_summarizeAction;
+    QAction *m_compareAction;
+    QAction *m_storageLayoutAction;
+    QAction *m_sampleAction;
     QAction *m_aboutAction;
 };
 
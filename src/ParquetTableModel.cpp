@@ -3,20 +3,103 @@
 // Undefine 'signals' macro from Qt to prevent conflict with arrow headers
 #undef signals
 #include <arrow/api.h>
+#include <arrow/filesystem/api.h>
 #include <arrow/io/api.h>
+#include <arrow/io/caching.h>
 #include <arrow/result.h>
 #include <parquet/arrow/reader.h>
 #include <arrow/array/array_binary.h>
+#include <parquet/arrow/schema.h>
+#include <parquet/exception.h>
 #include <parquet/file_reader.h>
+#include <parquet/properties.h>
 #include <string_view>
 
+#include "CachingRandomAccessFile.h"
+
 #include <QDateTime>
 #include <QDebug>
 #include <QFile>
+#include <QStringList>
+#include <QUrl>
 #include <QtTypes>
 
+// Remote I/O tuning: expected latency and bandwidth of a ranged GET, used to decide how aggressively
+// nearby byte ranges are coalesced, and the number of ranges fetched in parallel.
+static constexpr int64_t REMOTE_TIME_TO_FIRST_BYTE_MS = 50;
+static constexpr int64_t REMOTE_BANDWIDTH_MIB_PER_SEC = 100;
+static constexpr int REMOTE_IO_THREADS = 16;
+
+// Read size of streaming readers, which stop reading a column chunk once the rows they need are decoded
+static constexpr int64_t STREAM_BUFFER_SIZE = 1 << 20;
+
+// URIs with a scheme Arrow has a remote filesystem for go through its filesystem layer. An existing
+// local file is always local, even if its name looks like a URI (backup:v2.parquet).
+static bool isRemoteUri(const QString &filePath) {
+    static const QStringList remoteSchemes = {"s3", "gs", "gcs", "hdfs", "viewfs", "abfs", "abfss"};
+    if (QFile::exists(filePath)) {
+        return false;
+    }
+    return remoteSchemes.contains(QUrl(filePath).scheme(), Qt::CaseInsensitive);
+}
+
+// Remote reads are pre-buffered: the byte ranges of all column chunks a read needs are coalesced
+// and fetched in parallel on Arrow's I/O thread pool, instead of one small request at a time.
+static parquet::ArrowReaderProperties arrowReaderProperties(bool remote) {
+    parquet::ArrowReaderProperties properties = parquet::default_arrow_reader_properties();
+    if (remote) {
+        properties.set_pre_buffer(true);
+        properties.set_cache_options(arrow::io::CacheOptions::MakeFromNetworkMetrics(
+            REMOTE_TIME_TO_FIRST_BYTE_MS, REMOTE_BANDWIDTH_MIB_PER_SEC));
+    }
+    return properties;
+}
+
+// Opens a remote file behind a local disk cache of the byte ranges fetched from it
+static std::shared_ptr<CachingRandomAccessFile> openRemoteFile(const QString &uri) {
+    static bool ioPoolConfigured = false;
+    if (!ioPoolConfigured) {
+        arrow::Status pool_status = arrow::io::SetIOThreadPoolCapacity(REMOTE_IO_THREADS);
+        if (!pool_status.ok()) {
+            qWarning() << "Error configuring I/O thread pool:" << pool_status.ToString().c_str();
+        }
+        ioPoolConfigured = true;
+    }
+
+    std::string path;
+    arrow::Result<std::shared_ptr<arrow::fs::FileSystem>> fs_result = arrow::fs::FileSystemFromUri(uri.toStdString(), &path);
+    if (!fs_result.ok()) {
+        qWarning() << "Error resolving file system:" << fs_result.status().ToString().c_str();
+        return nullptr;
+    }
+    std::shared_ptr<arrow::fs::FileSystem> fs = *fs_result;
+
+    arrow::Result<arrow::fs::FileInfo> info_result = fs->GetFileInfo(path);
+    if (!info_result.ok()) {
+        qWarning() << "Error getting file info:" << info_result.status().ToString().c_str();
+        return nullptr;
+    }
+    if (info_result->type() != arrow::fs::FileType::File) {
+        qWarning() << "File does not exist:" << QUrl(uri).toDisplayString(QUrl::RemoveUserInfo);
+        return nullptr;
+    }
+
+    // Passing the FileInfo saves a second metadata request when opening
+    arrow::Result<std::shared_ptr<arrow::io::RandomAccessFile>> file_result = fs->OpenInputFile(*info_result);
+    if (!file_result.ok()) {
+        qWarning() << "Error opening file:" << file_result.status().ToString().c_str();
+        return nullptr;
+    }
+
+    int64_t modificationTime = info_result->mtime().time_since_epoch().count();
+    std::string cacheDirectory = CachingRandomAccessFile::cacheDirectoryFor(uri.toStdString(), info_result->size(), modificationTime);
+    return std::make_shared<CachingRandomAccessFile>(*file_result, info_result->size(), cacheDirectory);
+}
+
 ParquetTableModel::ParquetTableModel(QObject *parent)
     : QAbstractTableModel(parent),
+      m_isRemote(false),
+      m_fileSize(0),
       m_totalRows(0),
       m_numRowGroups(0),
       m_currentBatchIndex(-1) // -1 indicates no batch loaded
@@ -31,6 +114,9 @@ int ParquetTableModel::rowCount(const QModelIndex &parent) const {
     if (parent.isValid()) {
         return 0;
     }
+    if (m_sample) {
+        return static_cast<int>(m_sample->num_rows());
+    }
     return m_totalRows;
 }
 
@@ -75,6 +161,14 @@ QVariant ParquetTableModel::data(const QModelIndex &index, int role) const {
     int row = index.row();
     int col = index.column();
 
+    // The sample is a single in-memory table with one chunk per column
+    if (m_sample) {
+        if (row >= m_sample->num_rows() || col >= m_sample->num_columns()) {
+            return QVariant();
+        }
+        return valueAt(m_sample->column(col)->chunk(0), row);
+    }
+
     // Determine which batch this row belongs to
     int targetBatchIndex = row / BATCH_SIZE;
     int rowInBatch = row % BATCH_SIZE;
@@ -95,42 +189,46 @@ QVariant ParquetTableModel::data(const QModelIndex &index, int role) const {
         return QVariant();
     }
 
+    return valueAt(column_array, rowInBatch);
+}
+
+QVariant ParquetTableModel::valueAt(const std::shared_ptr<arrow::Array>& array, int64_t index) const {
     // Extract data based on Arrow type
-    switch (column_array->type_id()) {
+    switch (array->type_id()) {
         case arrow::Type::BOOL:
-            return std::static_pointer_cast<arrow::BooleanArray>(column_array)->Value(rowInBatch);
+            return std::static_pointer_cast<arrow::BooleanArray>(array)->Value(index);
         case arrow::Type::INT8:
-            return std::static_pointer_cast<arrow::Int8Array>(column_array)->Value(rowInBatch);
+            return std::static_pointer_cast<arrow::Int8Array>(array)->Value(index);
         case arrow::Type::INT16:
-            return std::static_pointer_cast<arrow::Int16Array>(column_array)->Value(rowInBatch);
+            return std::static_pointer_cast<arrow::Int16Array>(array)->Value(index);
         case arrow::Type::INT32:
-            return std::static_pointer_cast<arrow::Int32Array>(column_array)->Value(rowInBatch);
+            return std::static_pointer_cast<arrow::Int32Array>(array)->Value(index);
         case arrow::Type::INT64:
-            return static_cast<qlonglong>(std::static_pointer_cast<arrow::Int64Array>(column_array)->Value(rowInBatch));
+            return static_cast<qlonglong>(std::static_pointer_cast<arrow::Int64Array>(array)->Value(index));
         case arrow::Type::UINT8:
-            return std::static_pointer_cast<arrow::UInt8Array>(column_array)->Value(rowInBatch);
+            return std::static_pointer_cast<arrow::UInt8Array>(array)->Value(index);
         case arrow::Type::UINT16:
-            return std::static_pointer_cast<arrow::UInt16Array>(column_array)->Value(rowInBatch);
+            return std::static_pointer_cast<arrow::UInt16Array>(array)->Value(index);
         case arrow::Type::UINT32:
-            return std::static_pointer_cast<arrow::UInt32Array>(column_array)->Value(rowInBatch);
+            return std::static_pointer_cast<arrow::UInt32Array>(array)->Value(index);
         case arrow::Type::UINT64:
-            return static_cast<qulonglong>(std::static_pointer_cast<arrow::UInt64Array>(column_array)->Value(rowInBatch));
+            return static_cast<qulonglong>(std::static_pointer_cast<arrow::UInt64Array>(array)->Value(index));
         case arrow::Type::FLOAT:
-            return std::static_pointer_cast<arrow::FloatArray>(column_array)->Value(rowInBatch);
+            return std::static_pointer_cast<arrow::FloatArray>(array)->Value(index);
         case arrow::Type::DOUBLE:
-            return std::static_pointer_cast<arrow::DoubleArray>(column_array)->Value(rowInBatch);
+            return std::static_pointer_cast<arrow::DoubleArray>(array)->Value(index);
         case arrow::Type::STRING:
-            return getColumnString(column_array, rowInBatch);
+            return getColumnString(array, index);
         case arrow::Type::LARGE_STRING:
-            return getColumnLargeString(column_array, rowInBatch);
+            return getColumnLargeString(array, index);
         case arrow::Type::TIMESTAMP: {
-            auto timestamp_array = std::static_pointer_cast<arrow::TimestampArray>(column_array);
-            if (timestamp_array->IsNull(rowInBatch)) return QVariant();
+            auto timestamp_array = std::static_pointer_cast<arrow::TimestampArray>(array);
+            if (timestamp_array->IsNull(index)) return QVariant();
             // Convert Arrow timestamp to QDateTime
             // Arrow timestamps are typically microseconds, milliseconds, or seconds since epoch
             // QDateTime::fromSecsSinceEpoch expects seconds
             // This conversion might need refinement based on the actual unit of the timestamp
-            int64_t us_since_epoch = timestamp_array->Value(rowInBatch);
+            int64_t us_since_epoch = timestamp_array->Value(index);
             auto unit = std::static_pointer_cast<arrow::TimestampType>(timestamp_array->type())->unit();
             qint64 ms_since_epoch;
             switch (unit) {
@@ -145,10 +243,10 @@ QVariant ParquetTableModel::data(const QModelIndex &index, int role) const {
         // Add more types as needed
         default:
             // Fallback for unsupported types, try to convert to string
-            if (column_array->IsNull(rowInBatch)) {
+            if (array->IsNull(index)) {
                 return QVariant();
             }
-            auto scalar = column_array->GetScalar(rowInBatch);
+            auto scalar = array->GetScalar(index);
             if (scalar.ok() && (*scalar)->is_valid) {
                 return QString::fromStdString((*scalar)->ToString());
             }
@@ -161,6 +259,9 @@ QVariant ParquetTableModel::headerData(int section, Qt::Orientation orientation,
         if (orientation == Qt::Horizontal && m_schema && section < m_schema->num_fields()) {
             return QString::fromStdString(m_schema->field(section)->name());
         } else if (orientation == Qt::Vertical) {
+            if (m_sample && section < static_cast<int>(m_sampleRows.size())) {
+                return static_cast<qlonglong>(m_sampleRows[section]); // Row number in the file
+            }
             return section; // Row numbers
         }
     }
@@ -170,26 +271,54 @@ QVariant ParquetTableModel::headerData(int section, Qt::Orientation orientation,
 bool ParquetTableModel::loadParquetFile(const QString &filePath) {
     clearData(); // Clear any previously loaded data
 
-    if (!QFile::exists(filePath)) {
+    bool remote = isRemoteUri(filePath);
+    if (!remote && !QFile::exists(filePath)) {
         qWarning() << "File does not exist:" << filePath;
         return false;
     }
 
     m_filePath = filePath;
+    m_isRemote = remote;
+
+    if (remote) {
+        std::shared_ptr<CachingRandomAccessFile> cached = openRemoteFile(filePath);
+        if (!cached) {
+            return false;
+        }
+        m_source = cached;
+        m_scanSource = cached->uncached();
+    } else {
+        arrow::Result<std::shared_ptr<arrow::io::ReadableFile>> infile_result = arrow::io::ReadableFile::Open(filePath.toStdString());
+        if (!infile_result.ok()) {
+            qWarning() << "Error opening file:" << infile_result.status().ToString().c_str();
+            return false;
+        }
+        m_source = *infile_result;
+        m_scanSource = m_source;
+    }
 
-    arrow::Result<std::shared_ptr<arrow::io::ReadableFile>> infile_result = arrow::io::ReadableFile::Open(filePath.toStdString());
-    if (!infile_result.ok()) {
-        qWarning() << "Error opening file:" << infile_result.status().ToString().c_str();
+    arrow::Result<int64_t> size_result = m_source->GetSize();
+    if (!size_result.ok()) {
+        qWarning() << "Error getting file size:" << size_result.status().ToString().c_str();
         return false;
     }
-    std::shared_ptr<arrow::io::ReadableFile> infile = *infile_result;
+    m_fileSize = *size_result;
 
-    arrow::Result<std::unique_ptr<parquet::arrow::FileReader>> reader_result = parquet::arrow::OpenFile(infile, arrow::default_memory_pool());
-    if (!reader_result.ok()) {
-        qWarning() << "Error creating Parquet reader:" << reader_result.status().ToString().c_str();
+    parquet::arrow::FileReaderBuilder builder;
+    arrow::Status open_status = builder.Open(m_source);
+    if (!open_status.ok()) {
+        qWarning() << "Error opening Parquet file:" << open_status.ToString().c_str();
+        return false;
+    }
+    std::unique_ptr<parquet::arrow::FileReader> reader;
+    arrow::Status build_status = builder.memory_pool(arrow::default_memory_pool())
+                                     ->properties(arrowReaderProperties(m_isRemote))
+                                     ->Build(&reader);
+    if (!build_status.ok()) {
+        qWarning() << "Error creating Parquet reader:" << build_status.ToString().c_str();
         return false;
     }
-    m_parquetFileReader = std::move(*reader_result);
+    m_parquetFileReader = std::move(reader);
 
     // Get schema and number of rows
     arrow::Status schema_status = m_parquetFileReader->GetSchema(&m_schema);
@@ -211,24 +340,70 @@ bool ParquetTableModel::loadParquetFile(const QString &filePath) {
     return true;
 }
 
+QString ParquetTableModel::displayPath(const QString &filePath) {
+    if (!isRemoteUri(filePath)) {
+        return filePath;
+    }
+    return QUrl(filePath).toDisplayString(QUrl::RemoveUserInfo);
+}
+
 QString ParquetTableModel::filePath() const
 {
     return m_filePath;
 }
 
+bool ParquetTableModel::isRemote() const {
+    return m_isRemote;
+}
+
+qint64 ParquetTableModel::getFileSize() const {
+    return m_fileSize;
+}
+
 void ParquetTableModel::clearData()
 {
     beginResetModel();
     m_filePath.clear();
     m_parquetFileReader.reset();
+    m_source.reset();
+    m_scanSource.reset();
+    m_isRemote = false;
+    m_fileSize = 0;
     m_schema.reset();
     m_totalRows = 0;
     m_numRowGroups = 0;
     m_currentBatchIndex = -1;
     m_currentBatch.reset();
+    m_sample.reset();
+    m_sampleRows.clear();
     endResetModel();
 }
 
+void ParquetTableModel::showSample(const std::shared_ptr<arrow::Table> &sample, const std::vector<int64_t> &rowNumbers) {
+    if (!sample || !m_schema || sample->num_columns() != m_schema->num_fields()) {
+        qWarning() << "Sample does not match the loaded file";
+        return;
+    }
+    beginResetModel();
+    m_sample = sample;
+    m_sampleRows = rowNumbers;
+    endResetModel();
+}
+
+void ParquetTableModel::showFullFile() {
+    if (!m_sample) {
+        return;
+    }
+    beginResetModel();
+    m_sample.reset();
+    m_sampleRows.clear();
+    endResetModel();
+}
+
+bool ParquetTableModel::isSampleMode() const {
+    return m_sample != nullptr;
+}
+
 int ParquetTableModel::getTotalRows() const {
     return m_totalRows;
 }
@@ -245,6 +420,68 @@ std::shared_ptr<parquet::arrow::FileReader> ParquetTableModel::getFileReader() c
     return m_parquetFileReader;
 }
 
+std::shared_ptr<arrow::io::RandomAccessFile> ParquetTableModel::getSource() const {
+    return m_source;
+}
+
+std::shared_ptr<arrow::io::RandomAccessFile> ParquetTableModel::getScanSource() const {
+    return m_scanSource;
+}
+
+std::unique_ptr<parquet::arrow::FileReader> ParquetTableModel::createReader(ReadMode mode) const {
+    if (!m_source || !m_parquetFileReader) {
+        return nullptr;
+    }
+
+    parquet::ReaderProperties properties = parquet::default_reader_properties();
+    parquet::ArrowReaderProperties arrowProperties = arrowReaderProperties(m_isRemote);
+    if (mode == ReadMode::Stream) {
+        properties.enable_buffered_stream();
+        properties.set_buffer_size(STREAM_BUFFER_SIZE);
+        arrowProperties.set_pre_buffer(false);
+    }
+
+    std::unique_ptr<parquet::ParquetFileReader> parquet_reader;
+    try {
+        parquet_reader = parquet::ParquetFileReader::Open(mode == ReadMode::Scan ? m_scanSource : m_source, properties,
+                                                         m_parquetFileReader->parquet_reader()->metadata());
+    } catch (const parquet::ParquetException &e) {
+        qWarning() << "Error opening Parquet reader:" << e.what();
+        return nullptr;
+    }
+
+    std::unique_ptr<parquet::arrow::FileReader> reader;
+    arrow::Status status = parquet::arrow::FileReader::Make(arrow::default_memory_pool(), std::move(parquet_reader),
+                                                            arrowProperties, &reader);
+    if (!status.ok()) {
+        qWarning() << "Error creating Parquet reader:" << status.ToString().c_str();
+        return nullptr;
+    }
+    return reader;
+}
+
+static void collectLeafColumns(const parquet::arrow::SchemaField &field, std::vector<int> &out) {
+    if (field.is_leaf()) {
+        out.push_back(field.column_index);
+        return;
+    }
+    for (const auto &child : field.children) {
+        collectLeafColumns(child, out);
+    }
+}
+
+std::vector<int> ParquetTableModel::columnIndicesForField(int fieldIndex) const {
+    std::vector<int> indices;
+    if (!m_parquetFileReader) {
+        return indices;
+    }
+    const auto &fields = m_parquetFileReader->manifest().schema_fields;
+    if (fieldIndex >= 0 && fieldIndex < static_cast<int>(fields.size())) {
+        collectLeafColumns(fields[fieldIndex], indices);
+    }
+    return indices;
+}
+
 bool ParquetTableModel::loadBatch(int batchIndex) const {
     if (!m_parquetFileReader || batchIndex < 0) {
         return false;
@@ -259,36 +496,20 @@ bool ParquetTableModel::loadBatch(int batchIndex) const {
         return false;
     }
 
-    // Read a specific range of rows
-    // This is more efficient than reading entire row groups if the batch spans multiple row groups
-    // and we only need a portion of them.
-    // However, Parquet's native reading is by row group.
-    // For simplicity and to demonstrate virtual scrolling, we'll read a table and then slice it.
-    // A more optimized approach for very large files might involve reading specific row groups
-    // and then slicing, or using the Scan API.
-
-    // For now, let's read the entire table and then slice. This is not ideal for very large files
-    // but demonstrates the model's ability to handle batches.
-    // A better approach would be to read row groups that cover the batch.
-
-    // Let's refine this: we need to read row groups that cover the `start_row` to `start_row + num_rows_to_read`.
-    // This requires iterating through row groups.
-
-    // Simpler approach for now: read the entire file into an Arrow Table and then slice.
-    // This defeats the purpose of "virtual scroll" for memory, but keeps the UI responsive.
-    // The true virtual scroll for memory would involve reading only the necessary row groups.
-    // Given the requirement "only load 10000 parquet rows at a time", this implies memory efficiency.
-
-    // Let's try to read row groups.
+    // Read the row groups covering the batch, then cut the batch out of them
+    std::shared_ptr<parquet::FileMetaData> metadata = m_parquetFileReader->parquet_reader()->metadata();
     std::vector<int> row_group_indices;
+    int64_t first_group_row = -1;
     int64_t current_row_count = 0;
     int64_t target_end_row = start_row + num_rows_to_read;
 
     for (int i = 0; i < m_numRowGroups; ++i) {
-        std::shared_ptr<parquet::FileMetaData> metadata = m_parquetFileReader->parquet_reader()->metadata();
         int64_t rg_num_rows = metadata->RowGroup(i)->num_rows();
 
         if (current_row_count + rg_num_rows > start_row && current_row_count < target_end_row) {
+            if (row_group_indices.empty()) {
+                first_group_row = current_row_count;
+            }
             row_group_indices.push_back(i);
         }
         current_row_count += rg_num_rows;
@@ -300,29 +521,21 @@ bool ParquetTableModel::loadBatch(int batchIndex) const {
         return false;
     }
 
-    std::shared_ptr<arrow::Table> full_table_for_batch;
-    arrow::Status read_status = m_parquetFileReader->ReadRowGroups(row_group_indices, &full_table_for_batch);
-    if (!read_status.ok()) {
-        qWarning() << "Failed to read row groups:" << read_status.ToString().c_str();
+    std::shared_ptr<arrow::Table> row_groups;
+    arrow::Status batch_status = m_parquetFileReader->ReadRowGroups(row_group_indices, &row_groups);
+    if (!batch_status.ok()) {
+        qWarning() << "Failed to read batch:" << batch_status.ToString().c_str();
         return false;
     }
 
-    // Now slice the table to get the exact batch
-    int64_t offset_in_full_table = start_row - (static_cast<int64_t>(batchIndex) * BATCH_SIZE); // This needs to be calculated based on actual row group boundaries
-    // This logic is tricky. If we read row groups, the `start_row` might not be the start of a row group.
-    // The `ReadRowGroups` reads entire row groups.
-    // A simpler approach for the "10000 rows at a time" is to use `ReadTable` and then `Slice`.
-    // This will load the *entire* file into memory if `ReadTable` is used without limits.
-    // The user explicitly asked for "only load 10000 parquet rows at a time".
-
-    // Let's re-evaluate. The `parquet::arrow::FileReader` has `ReadTable(int64_t offset, int64_t num_rows, ...)`
-    // This is exactly what we need for virtual scrolling.
-
-    arrow::Status batch_status = m_parquetFileReader->ReadRowGroups(row_group_indices, &m_currentBatch);
-    if (!batch_status.ok()) {
-        qWarning() << "Failed to read batch:" << batch_status.ToString().c_str();
+    // Row groups rarely align with batches, and data() indexes a single chunk per column
+    arrow::Result<std::shared_ptr<arrow::Table>> batch =
+        row_groups->Slice(start_row - first_group_row, num_rows_to_read)->CombineChunks();
+    if (!batch.ok()) {
+        qWarning() << "Failed to combine batch:" << batch.status().ToString().c_str();
         return false;
     }
+    m_currentBatch = *batch;
 
     m_currentBatchIndex = batchIndex;
     return true;
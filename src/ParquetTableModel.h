@@ -6,12 +6,16 @@
 #include <QVector>
 #include <QVariant>
 #include <memory>
+#include <vector>
 
 // Forward declarations for Arrow types
 namespace arrow {
     class Table;
     class Schema;
     class Array;
+    namespace io {
+        class RandomAccessFile;
+    }
 }
 namespace parquet {
     namespace arrow {
@@ -36,15 +40,49 @@ public:
     bool loadParquetFile(const QString &filePath);
     void clearData();
 
+    // Sample mode: shows an in-memory sample of the file instead of paging through all of it.
+    // rowNumbers holds the row number in the file of every sample row, shown as the row header.
+    void showSample(const std::shared_ptr<arrow::Table> &sample, const std::vector<int64_t> &rowNumbers);
+    void showFullFile();
+    bool isSampleMode() const;
+
+    // The path or URI as it may be shown to the user: the user info (access keys) of URIs is left out
+    static QString displayPath(const QString &filePath);
+
     // Getters for file info
     QString filePath() const;
+    bool isRemote() const;
+    qint64 getFileSize() const;
     int getTotalRows() const;
     int getNumRowGroups() const;
     std::shared_ptr<arrow::Schema> getSchema() const;
     std::shared_ptr<parquet::arrow::FileReader> getFileReader() const;
+    std::shared_ptr<arrow::io::RandomAccessFile> getSource() const;
+    // The file without the local range cache of remote files. Whole-file scans read through this,
+    // as they would only flush the cache while filling the disk.
+    std::shared_ptr<arrow::io::RandomAccessFile> getScanSource() const;
+
+    // How a reader from createReader() gets at the file
+    enum class ReadMode {
+        Browse, // Through the range cache, pre-buffering whole column chunks of remote files
+        Scan,   // Past the range cache, for whole-file scans
+        Stream  // Through the range cache, a buffer at a time as pages are decoded, for partial reads
+    };
+
+    // Opens an independent reader over the loaded file, reusing the already parsed footer.
+    // Background jobs use this so they never share m_parquetFileReader across threads. It may be
+    // called from worker threads as long as the model is not reloaded meanwhile.
+    std::unique_ptr<parquet::arrow::FileReader> createReader(ReadMode mode = ReadMode::Browse) const;
+
+    // Parquet leaf column indices making up a top-level schema field (several for nested types)
+    std::vector<int> columnIndicesForField(int fieldIndex) const;
 
 private:
     QString m_filePath;
+    std::shared_ptr<arrow::io::RandomAccessFile> m_source;
+    std::shared_ptr<arrow::io::RandomAccessFile> m_scanSource;
+    bool m_isRemote;
+    qint64 m_fileSize;
     std::shared_ptr<parquet::arrow::FileReader> m_parquetFileReader;
     std::shared_ptr<arrow::Schema> m_schema;
     int m_totalRows;
@@ -55,9 +93,15 @@ private:
     mutable int m_currentBatchIndex; // Which batch is currently loaded (0-based)
     mutable std::shared_ptr<arrow::Table> m_currentBatch; // The currently loaded batch of data
 
+    // Sample mode
+    std::shared_ptr<arrow::Table> m_sample; // Set while sample mode is active
+    std::vector<int64_t> m_sampleRows;
+
     // Helper to load a specific batch
     bool loadBatch(int batchIndex) const;
 
+    QVariant valueAt(const std::shared_ptr<arrow::Array>& array, int64_t index) const;
+
     QString getColumnString(const std::shared_ptr<arrow::Array>& array, int64_t index) const;
     QString getColumnLargeString(const std::shared_ptr<arrow::Array>& array, int64_t index) const;
 };
@@ -0,0 +1,198 @@
+#include "SampleDialog.h"
+#include "ParquetTableModel.h"
+#include "TableUtils.h"
+
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLocale>
+#include <QMessageBox>
+#include <QVBoxLayout>
+
+static constexpr int DEFAULT_SAMPLE_SIZE = 10000;
+static constexpr int MAX_SAMPLE_SIZE = 10000000;
+
+SampleDialog::SampleDialog(QWidget *parent)
+    : QDialog(parent),
+      m_model(nullptr),
+      m_job(nullptr) {
+    setWindowTitle("Sample Mode");
+    setMinimumSize(800, 450);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    QFormLayout *formLayout = new QFormLayout();
+    m_sampleSizeSpinBox = new QSpinBox(this);
+    m_sampleSizeSpinBox->setRange(1, MAX_SAMPLE_SIZE);
+    m_sampleSizeSpinBox->setValue(DEFAULT_SAMPLE_SIZE);
+    m_sampleSizeSpinBox->setGroupSeparatorShown(true);
+    formLayout->addRow("Sample size (rows):", m_sampleSizeSpinBox);
+    mainLayout->addLayout(formLayout);
+
+    m_statisticsTable = new QTableWidget(this);
+    m_statisticsTable->setColumnCount(7);
+    m_statisticsTable->setHorizontalHeaderLabels({"Column", "Type", "Null %", "Distinct (in sample)",
+                                                  "Min", "Max", "Mean"});
+    m_statisticsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_statisticsTable->setAlternatingRowColors(true);
+    m_statisticsTable->verticalHeader()->setVisible(false);
+    m_statisticsTable->horizontalHeader()->setStretchLastSection(true);
+    mainLayout->addWidget(m_statisticsTable);
+
+    m_progressBar = new QProgressBar(this);
+    mainLayout->addWidget(m_progressBar);
+    m_statusLabel = new QLabel(this);
+    mainLayout->addWidget(m_statusLabel);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    buttonLayout->addStretch();
+
+    m_sampleButton = new QPushButton("Take Sample", this);
+    connect(m_sampleButton, &QPushButton::clicked, this, &SampleDialog::takeSample);
+    buttonLayout->addWidget(m_sampleButton);
+
+    m_cancelButton = new QPushButton("Cancel", this);
+    connect(m_cancelButton, &QPushButton::clicked, this, &SampleDialog::cancelSample);
+    buttonLayout->addWidget(m_cancelButton);
+
+    m_fullFileButton = new QPushButton("Show Full File", this);
+    connect(m_fullFileButton, &QPushButton::clicked, this, &SampleDialog::showFullFile);
+    buttonLayout->addWidget(m_fullFileButton);
+
+    QPushButton *closeButton = new QPushButton("Close", this);
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::accept);
+    buttonLayout->addWidget(closeButton);
+
+    mainLayout->addLayout(buttonLayout);
+
+    setRunning(false);
+}
+
+SampleDialog::~SampleDialog() {
+    stopJob();
+}
+
+void SampleDialog::setTableModel(ParquetTableModel *model) {
+    stopJob();
+    m_model = model;
+    m_statisticsTable->setRowCount(0);
+    m_progressBar->reset();
+    m_statusLabel->setText("The sample is drawn from a few random row groups; statistics are approximate.");
+    setRunning(false);
+}
+
+void SampleDialog::takeSample() {
+    if (!m_model || !m_model->getFileReader()) {
+        return;
+    }
+
+    stopJob();
+    m_job = new SampleJob(m_model, m_sampleSizeSpinBox->value(), this);
+    connect(m_job, &SampleJob::progress, this, &SampleDialog::onProgress);
+    connect(m_job, &SampleJob::finished, this, &SampleDialog::onFinished);
+    connect(m_job, &SampleJob::failed, this, &SampleDialog::onFailed);
+
+    m_progressBar->setRange(0, 0); // Busy until the first row group is sampled
+    m_statusLabel->setText("Sampling...");
+    setRunning(true);
+    m_job->start();
+}
+
+void SampleDialog::cancelSample() {
+    if (!m_job) {
+        return;
+    }
+    m_job->cancel();
+    m_progressBar->reset();
+    m_statusLabel->setText("Sampling cancelled.");
+    setRunning(false);
+}
+
+void SampleDialog::showFullFile() {
+    if (!m_model) {
+        return;
+    }
+    m_model->showFullFile();
+    m_statusLabel->setText("Showing the full file.");
+    setRunning(false);
+    emit sampleModeChanged(false);
+}
+
+void SampleDialog::onProgress(int rowGroupsDone, int rowGroupsTotal) {
+    if (!BackgroundJob::isCurrent(m_job, sender())) {
+        return;
+    }
+    m_progressBar->setRange(0, rowGroupsTotal);
+    m_progressBar->setValue(rowGroupsDone);
+    m_statusLabel->setText(QString("Sampled %1 of %2 row groups").arg(rowGroupsDone).arg(rowGroupsTotal));
+}
+
+void SampleDialog::onFinished() {
+    if (!BackgroundJob::isCurrent(m_job, sender())) {
+        return;
+    }
+    m_progressBar->setRange(0, 1);
+    m_progressBar->setValue(1);
+
+    std::shared_ptr<arrow::Table> sample = m_job->sample();
+    std::vector<int64_t> sourceRows = m_job->sourceRows();
+    m_model->showSample(sample, sourceRows);
+    populateStatisticsTable();
+
+    QLocale locale;
+    // A cluster sample: rows outside the picked row groups had no chance to be drawn
+    QString status = QString("Showing %1 rows drawn from %2 rows in %3 of %4 row groups.")
+                         .arg(locale.toString(static_cast<qlonglong>(sourceRows.size())))
+                         .arg(locale.toString(m_job->rowsScanned()))
+                         .arg(locale.toString(m_job->rowGroupsSampled()))
+                         .arg(locale.toString(m_model->getNumRowGroups()));
+    if (m_job->rowsScanned() < m_model->getTotalRows()) {
+        status += " Rows outside them cannot appear.";
+    }
+    m_statusLabel->setText(status + " Statistics are approximate.");
+    setRunning(false);
+    emit sampleModeChanged(m_model->isSampleMode());
+}
+
+void SampleDialog::onFailed(const QString &message) {
+    if (!BackgroundJob::isCurrent(m_job, sender())) {
+        return;
+    }
+    m_progressBar->reset();
+    setRunning(false);
+    QMessageBox::critical(this, "Sample Mode", message);
+}
+
+void SampleDialog::populateStatisticsTable() {
+    QLocale locale;
+    QVector<SampleColumnStats> statistics = m_job->statistics();
+    qint64 sampleRows = static_cast<qint64>(m_job->sourceRows().size());
+
+    m_statisticsTable->setRowCount(statistics.size());
+    for (int row = 0; row < statistics.size(); ++row) {
+        const SampleColumnStats &stats = statistics[row];
+        m_statisticsTable->setItem(row, 0, readOnlyItem(stats.name));
+        m_statisticsTable->setItem(row, 1, readOnlyItem(stats.type));
+        m_statisticsTable->setItem(row, 2, readOnlyItem(sampleRows > 0
+            ? locale.toString(100.0 * stats.nullCount / sampleRows, 'f', 1) + " %" : QString("-")));
+        m_statisticsTable->setItem(row, 3, readOnlyItem(stats.distinctCount >= 0
+            ? locale.toString(stats.distinctCount) : QString("-")));
+        m_statisticsTable->setItem(row, 4, readOnlyItem(stats.min.isEmpty() ? QString("-") : stats.min));
+        m_statisticsTable->setItem(row, 5, readOnlyItem(stats.max.isEmpty() ? QString("-") : stats.max));
+        m_statisticsTable->setItem(row, 6, readOnlyItem(stats.mean.isEmpty() ? QString("-") : stats.mean));
+    }
+    m_statisticsTable->resizeColumnsToContents();
+}
+
+void SampleDialog::stopJob() {
+    BackgroundJob::retire(m_job);
+    m_job = nullptr;
+}
+
+void SampleDialog::setRunning(bool running) {
+    bool hasFile = m_model && m_model->getFileReader();
+    m_sampleSizeSpinBox->setEnabled(hasFile && !running);
+    m_sampleButton->setEnabled(hasFile && !running);
+    m_cancelButton->setEnabled(running);
+    m_fullFileButton->setEnabled(hasFile && !running && m_model->isSampleMode());
+}
@@ -0,0 +1,55 @@
+#ifndef SAMPLEDIALOG_H
+#define SAMPLEDIALOG_H
+
+#include <QDialog>
+#include <QLabel>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTableWidget>
+
+#include "SampleJob.h"
+
+class ParquetTableModel;
+
+class SampleDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit SampleDialog(QWidget *parent = nullptr);
+    ~SampleDialog() override;
+
+    // Resets the dialog for the loaded file, cancelling any running sample
+    void setTableModel(ParquetTableModel *model);
+
+    // Cancels and waits for the running job; it must be stopped before the model is reloaded
+    void stopJob();
+
+signals:
+    void sampleModeChanged(bool sampleMode);
+
+private slots:
+    void takeSample();
+    void cancelSample();
+    void showFullFile();
+    void onProgress(int rowGroupsDone, int rowGroupsTotal);
+    void onFinished();
+    void onFailed(const QString &message);
+
+private:
+    void setRunning(bool running);
+    void populateStatisticsTable();
+
+    ParquetTableModel *m_model;
+    SampleJob *m_job;
+
+    QSpinBox *m_sampleSizeSpinBox;
+    QTableWidget *m_statisticsTable;
+    QPushButton *m_sampleButton;
+    QPushButton *m_cancelButton;
+    QPushButton *m_fullFileButton;
+    QProgressBar *m_progressBar;
+    QLabel *m_statusLabel;
+};
+
+#endif // SAMPLEDIALOG_H
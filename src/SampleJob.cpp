@@ -0,0 +1,374 @@
+#include "SampleJob.h"
+#include "ParquetTableModel.h"
+
+// Undefine 'signals' macro from Qt to prevent conflict with arrow headers
+#undef signals
+#include <arrow/api.h>
+#include <arrow/compute/api.h>
+#include <arrow/type_traits.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/file_reader.h>
+#include <parquet/metadata.h>
+
+#include <QDebug>
+#include <QLocale>
+#include <QThread>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <tuple>
+
+// Row groups are picked until they hold this many times the requested sample size, so every
+// row group contributes only a fraction of the sample
+static constexpr int SAMPLE_OVERSAMPLING = 4;
+
+// Rows decoded at a time, which bounds how long a cancellation waits
+static constexpr int64_t SAMPLE_BATCH_ROWS = 8192;
+
+// Selects the given rows of a table, in the given order
+static arrow::Result<std::shared_ptr<arrow::Table>> takeRows(const std::shared_ptr<arrow::Table> &table,
+                                                              const std::vector<int64_t> &rows) {
+    arrow::Int64Builder builder;
+    ARROW_RETURN_NOT_OK(builder.AppendValues(rows));
+    ARROW_ASSIGN_OR_RAISE(std::shared_ptr<arrow::Array> indices, builder.Finish());
+    ARROW_ASSIGN_OR_RAISE(arrow::Datum taken, arrow::compute::Take(table, indices));
+    return taken.table();
+}
+
+SampleJob::SampleJob(const ParquetTableModel *model, qint64 sampleSize, QObject *parent)
+    : BackgroundJob(parent),
+      m_model(model),
+      m_sampleSize(std::max<qint64>(sampleSize, 1)),
+      m_rowGroupsDone(0),
+      m_rowsScanned(0)
+{
+    auto metadata = model->getFileReader()->parquet_reader()->metadata();
+    int64_t offset = 0;
+    for (int i = 0; i < metadata->num_row_groups(); ++i) {
+        m_rowGroupOffsets.push_back(offset);
+        offset += metadata->RowGroup(i)->num_rows();
+    }
+    for (int field = 0; field < model->getSchema()->num_fields(); ++field) {
+        std::vector<int> leaves = model->columnIndicesForField(field);
+        m_columnIndices.insert(m_columnIndices.end(), leaves.begin(), leaves.end());
+    }
+
+    // Spread the sample over at least one row group per pool thread, adding row groups until they
+    // hold enough rows; more row groups cost more decoding but make the sample less clustered
+    std::mt19937_64 rng(std::random_device{}());
+    std::vector<int> order(metadata->num_row_groups());
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), rng);
+
+    const int64_t rowsWanted = m_sampleSize * SAMPLE_OVERSAMPLING;
+    const size_t rowGroupsWanted = static_cast<size_t>(std::max(QThread::idealThreadCount(), 1));
+    int64_t rows = 0;
+    for (int rowGroup : order) {
+        if (rows >= rowsWanted && m_rowGroups.size() >= rowGroupsWanted) {
+            break;
+        }
+        const int64_t rowGroupRows = metadata->RowGroup(rowGroup)->num_rows();
+        if (rowGroupRows == 0) {
+            continue;
+        }
+        m_rowGroups.push_back(rowGroup);
+        rows += rowGroupRows;
+    }
+    std::sort(m_rowGroups.begin(), m_rowGroups.end());
+    for (size_t i = 0; i < m_rowGroups.size(); ++i) {
+        m_seeds.push_back(rng());
+    }
+}
+
+SampleJob::~SampleJob() {
+    stopTasks();
+}
+
+void SampleJob::start() {
+    if (m_rowGroups.empty()) {
+        QString error;
+        if (!mergeCandidates(error)) {
+            fail(error);
+            return;
+        }
+        computeStatistics();
+        emit finished();
+        return;
+    }
+
+    for (size_t index = 0; index < m_rowGroups.size(); ++index) {
+        m_pool.start([this, index]() {
+            sampleRowGroup(index);
+        });
+    }
+}
+
+std::shared_ptr<arrow::Table> SampleJob::sample() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_sample;
+}
+
+std::vector<int64_t> SampleJob::sourceRows() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_sourceRows;
+}
+
+QVector<SampleColumnStats> SampleJob::statistics() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_statistics;
+}
+
+qint64 SampleJob::rowsScanned() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_rowsScanned;
+}
+
+int SampleJob::rowGroupsSampled() const {
+    return static_cast<int>(m_rowGroups.size());
+}
+
+void SampleJob::sampleRowGroup(size_t index) {
+    if (isCancelled()) {
+        return;
+    }
+
+    // A streaming reader fetches column chunks as they are decoded, so memory stays at a few batches
+    parquet::arrow::FileReader *reader = threadReader(m_model, ParquetTableModel::ReadMode::Stream);
+    if (!reader) {
+        fail("Could not open a reader for the Parquet file.");
+        return;
+    }
+
+    const int rowGroup = m_rowGroups[index];
+    reader->set_batch_size(SAMPLE_BATCH_ROWS);
+    std::unique_ptr<arrow::RecordBatchReader> batches;
+    arrow::Status status = reader->GetRecordBatchReader({rowGroup}, m_columnIndices, &batches);
+    if (!status.ok()) {
+        fail(QString("Failed to read row group %1: %2").arg(rowGroup).arg(status.ToString().c_str()));
+        return;
+    }
+
+    // Every decoded row gets a key. A row whose key is above the largest of the smallest keys kept
+    // so far can never be sampled and is dropped at once; the rest are compacted once they reach
+    // twice the sample size.
+    std::mt19937_64 rng(m_seeds[index]);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    Candidates candidates;
+    candidates.rowGroup = rowGroup;
+    double threshold = 1.0;
+    int64_t position = 0;
+    QString error;
+    while (true) {
+        if (isCancelled()) {
+            return;
+        }
+        std::shared_ptr<arrow::RecordBatch> batch;
+        status = batches->ReadNext(&batch);
+        if (!status.ok()) {
+            fail(QString("Failed to read row group %1: %2").arg(rowGroup).arg(status.ToString().c_str()));
+            return;
+        }
+        if (!batch) {
+            break;
+        }
+
+        std::vector<int64_t> picked;
+        for (int64_t row = 0; row < batch->num_rows(); ++row) {
+            double key = distribution(rng);
+            if (key < threshold) {
+                picked.push_back(row);
+                candidates.keys.push_back(key);
+                candidates.rows.push_back(position + row);
+            }
+        }
+        position += batch->num_rows();
+        if (!picked.empty()) {
+            arrow::Result<std::shared_ptr<arrow::Table>> taken = arrow::Table::FromRecordBatches(batches->schema(), {batch});
+            if (taken.ok()) {
+                taken = takeRows(*taken, picked);
+            }
+            if (!taken.ok()) {
+                fail(QString("Failed to sample row group %1: %2").arg(rowGroup).arg(taken.status().ToString().c_str()));
+                return;
+            }
+            candidates.pieces.push_back(*taken);
+        }
+
+        if (static_cast<qint64>(candidates.keys.size()) >= 2 * m_sampleSize) {
+            if (!keepSmallestKeys(candidates, error)) {
+                fail(error);
+                return;
+            }
+            threshold = *std::max_element(candidates.keys.begin(), candidates.keys.end());
+        }
+    }
+    if (!keepSmallestKeys(candidates, error)) {
+        fail(error);
+        return;
+    }
+
+    if (isCancelled()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_candidates.push_back(std::move(candidates));
+        m_rowsScanned += position;
+    }
+
+    int done = ++m_rowGroupsDone;
+    emit progress(done, static_cast<int>(m_rowGroups.size()));
+    if (done == static_cast<int>(m_rowGroups.size())) {
+        if (!mergeCandidates(error)) {
+            fail(error);
+            return;
+        }
+        computeStatistics();
+        if (!isCancelled()) {
+            emit finished();
+        }
+    }
+}
+
+bool SampleJob::keepSmallestKeys(Candidates &candidates, QString &error) const {
+    if (candidates.pieces.empty()) {
+        return true;
+    }
+    arrow::Result<std::shared_ptr<arrow::Table>> table = arrow::ConcatenateTables(candidates.pieces);
+    if (!table.ok()) {
+        error = QString("Failed to sample row group %1: %2").arg(candidates.rowGroup).arg(table.status().ToString().c_str());
+        return false;
+    }
+    candidates.pieces = {*table};
+    if (static_cast<qint64>(candidates.keys.size()) <= m_sampleSize) {
+        return true;
+    }
+
+    // Positions of the smallest keys, back in file order
+    std::vector<int64_t> positions(candidates.keys.size());
+    std::iota(positions.begin(), positions.end(), 0);
+    std::nth_element(positions.begin(), positions.begin() + m_sampleSize, positions.end(),
+                     [&candidates](int64_t a, int64_t b) { return candidates.keys[a] < candidates.keys[b]; });
+    positions.resize(static_cast<size_t>(m_sampleSize));
+    std::sort(positions.begin(), positions.end());
+
+    arrow::Result<std::shared_ptr<arrow::Table>> taken = takeRows(*table, positions);
+    if (!taken.ok()) {
+        error = QString("Failed to sample row group %1: %2").arg(candidates.rowGroup).arg(taken.status().ToString().c_str());
+        return false;
+    }
+    std::vector<double> keys;
+    std::vector<int64_t> rows;
+    for (int64_t position : positions) {
+        keys.push_back(candidates.keys[position]);
+        rows.push_back(candidates.rows[position]);
+    }
+    candidates.keys = std::move(keys);
+    candidates.rows = std::move(rows);
+    candidates.pieces = {*taken};
+    return true;
+}
+
+bool SampleJob::mergeCandidates(QString &error) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Row group order keeps the sample in file order
+    std::sort(m_candidates.begin(), m_candidates.end(), [](const Candidates &a, const Candidates &b) {
+        return a.rowGroup < b.rowGroup;
+    });
+
+    // (key, candidate, position) of every candidate row; the smallest keys across row groups win
+    std::vector<std::tuple<double, size_t, size_t>> all;
+    for (size_t c = 0; c < m_candidates.size(); ++c) {
+        for (size_t i = 0; i < m_candidates[c].keys.size(); ++i) {
+            all.emplace_back(m_candidates[c].keys[i], c, i);
+        }
+    }
+    if (static_cast<qint64>(all.size()) > m_sampleSize) {
+        std::nth_element(all.begin(), all.begin() + m_sampleSize, all.end());
+        all.resize(static_cast<size_t>(m_sampleSize));
+    }
+
+    std::vector<std::vector<int64_t>> selected(m_candidates.size());
+    for (const auto &[key, c, i] : all) {
+        selected[c].push_back(static_cast<int64_t>(i));
+    }
+
+    std::vector<std::shared_ptr<arrow::Table>> tables;
+    m_sourceRows.clear();
+    for (size_t c = 0; c < m_candidates.size(); ++c) {
+        std::vector<int64_t> &positions = selected[c];
+        if (positions.empty()) {
+            continue;
+        }
+        std::sort(positions.begin(), positions.end());
+        arrow::Result<std::shared_ptr<arrow::Table>> taken = takeRows(m_candidates[c].pieces.front(), positions);
+        if (!taken.ok()) {
+            error = QString("Failed to merge the sample: %1").arg(taken.status().ToString().c_str());
+            return false;
+        }
+        tables.push_back(*taken);
+        const int64_t firstRow = m_rowGroupOffsets[m_candidates[c].rowGroup];
+        for (int64_t position : positions) {
+            m_sourceRows.push_back(firstRow + m_candidates[c].rows[position]);
+        }
+    }
+    m_candidates.clear();
+
+    arrow::Result<std::shared_ptr<arrow::Table>> sample = tables.empty()
+        ? arrow::Table::MakeEmpty(m_model->getSchema())
+        : arrow::ConcatenateTables(tables);
+    if (sample.ok()) {
+        // A single chunk per column lets the model index the sample directly
+        sample = (*sample)->CombineChunks();
+    }
+    if (!sample.ok()) {
+        error = QString("Failed to merge the sample: %1").arg(sample.status().ToString().c_str());
+        return false;
+    }
+    m_sample = *sample;
+    return true;
+}
+
+void SampleJob::computeStatistics() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_statistics.clear();
+    if (!m_sample) {
+        return;
+    }
+
+    QLocale locale;
+    for (int i = 0; i < m_sample->num_columns(); ++i) {
+        std::shared_ptr<arrow::Field> field = m_sample->schema()->field(i);
+        std::shared_ptr<arrow::ChunkedArray> column = m_sample->column(i);
+
+        SampleColumnStats stats;
+        stats.name = QString::fromStdString(field->name());
+        stats.type = QString::fromStdString(field->type()->ToString());
+        stats.nullCount = column->null_count();
+
+        auto distinct = arrow::compute::CallFunction("count_distinct", {column});
+        if (distinct.ok()) {
+            stats.distinctCount = std::static_pointer_cast<arrow::Int64Scalar>(distinct->scalar())->value;
+        }
+
+        auto minMax = arrow::compute::MinMax(column);
+        if (minMax.ok()) {
+            const auto &values = minMax->scalar_as<arrow::StructScalar>().value;
+            if (values.size() == 2 && values[0]->is_valid) {
+                stats.min = QString::fromStdString(values[0]->ToString());
+                stats.max = QString::fromStdString(values[1]->ToString());
+            }
+        }
+
+        if (arrow::is_numeric(field->type()->id())) {
+            auto mean = arrow::compute::Mean(column);
+            if (mean.ok() && mean->scalar()->is_valid) {
+                stats.mean = locale.toString(mean->scalar_as<arrow::DoubleScalar>().value, 'g', 10);
+            }
+        }
+
+        m_statistics.append(stats);
+    }
+}
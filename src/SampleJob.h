@@ -0,0 +1,86 @@
+#ifndef SAMPLEJOB_H
+#define SAMPLEJOB_H
+
+#include "BackgroundJob.h"
+
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class ParquetTableModel;
+namespace arrow {
+    class Table;
+}
+namespace parquet {
+    namespace arrow {
+        class FileReader;
+    }
+}
+
+// Approximate statistics of one column, computed from the sample
+struct SampleColumnStats {
+    QString name;
+    QString type;
+    qint64 nullCount = 0;
+    qint64 distinctCount = -1; // -1 when not computable for the type
+    QString min;
+    QString max;
+    QString mean;
+};
+
+// Builds a two-stage cluster sample of a Parquet file, not a uniform sample of all its rows.
+// Stage one picks random row groups, at least one per pool thread and more until they hold several
+// times the requested number of rows. Stage two streams every picked row group in small batches,
+// gives each decoded row a random key and keeps the rows with the smallest keys, first per row
+// group and then across them. Rows of row groups that were not picked can never appear in the sample.
+class SampleJob : public BackgroundJob {
+    Q_OBJECT
+
+public:
+    SampleJob(const ParquetTableModel *model, qint64 sampleSize, QObject *parent = nullptr);
+    ~SampleJob() override;
+
+    void start() override;
+
+    // Valid once finished() has been emitted
+    std::shared_ptr<arrow::Table> sample() const;
+    std::vector<int64_t> sourceRows() const; // Row number in the file of every sampled row
+    QVector<SampleColumnStats> statistics() const;
+    qint64 rowsScanned() const; // Rows in the row groups the sample was drawn from
+    int rowGroupsSampled() const;
+
+private:
+    // Rows of one row group with the smallest random keys seen so far, in file order
+    struct Candidates {
+        int rowGroup = 0;
+        std::vector<double> keys;
+        std::vector<int64_t> rows; // Within the row group
+        std::vector<std::shared_ptr<arrow::Table>> pieces; // The rows' data, in the same order
+    };
+
+    void sampleRowGroup(size_t index);
+    bool keepSmallestKeys(Candidates &candidates, QString &error) const;
+    bool mergeCandidates(QString &error);
+    void computeStatistics();
+
+    const ParquetTableModel *m_model;
+    qint64 m_sampleSize;
+    std::vector<int64_t> m_rowGroupOffsets;
+    std::vector<int> m_rowGroups; // Picked row groups, ascending
+    std::vector<uint64_t> m_seeds; // Random key seed of every picked row group
+    std::vector<int> m_columnIndices;
+
+    std::atomic<int> m_rowGroupsDone;
+
+    mutable std::mutex m_mutex;
+    std::vector<Candidates> m_candidates;
+    qint64 m_rowsScanned;
+    std::shared_ptr<arrow::Table> m_sample;
+    std::vector<int64_t> m_sourceRows;
+    QVector<SampleColumnStats> m_statistics;
+};
+
+#endif // SAMPLEJOB_H
@@ -0,0 +1,278 @@
+#include "StorageLayoutDialog.h"
+#include "FileInfoDialog.h"
+#include "ParquetTableModel.h"
+#include "TableUtils.h"
+
+// Undefine 'signals' macro from Qt to prevent conflict with arrow headers
+#undef signals
+#include <arrow/api.h>
+#include <arrow/util/compression.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/file_reader.h>
+#include <parquet/metadata.h>
+
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLocale>
+#include <QMessageBox>
+#include <QSet>
+#include <QShowEvent>
+#include <QTabWidget>
+#include <QVBoxLayout>
+
+#include <algorithm>
+
+enum ColumnTableColumn {
+    ColumnName,
+    ColumnType,
+    ColumnCodecs,
+    ColumnCompressed,
+    ColumnUncompressed,
+    ColumnRatio,
+    ColumnShare,
+    ColumnDecodeSeconds,
+    ColumnDecodeMBps,
+    ColumnDecodeRowsps,
+    ColumnTableColumnCount
+};
+
+StorageLayoutDialog::StorageLayoutDialog(QWidget *parent)
+    : QDialog(parent),
+      m_model(nullptr),
+      m_job(nullptr),
+      m_populated(false) {
+    setWindowTitle("Storage Layout");
+    setMinimumSize(900, 500);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    QTabWidget *tabs = new QTabWidget(this);
+
+    m_columnTable = new QTableWidget(this);
+    m_columnTable->setColumnCount(ColumnTableColumnCount);
+    m_columnTable->setHorizontalHeaderLabels({"Column", "Type", "Codecs", "Compressed", "Uncompressed", "Ratio",
+                                              "Share of File", "Decode Time (s)", "Decode MB/s", "Decode Rows/s"});
+    tabs->addTab(m_columnTable, "Columns");
+
+    // One row per column chunk can be millions of rows, so the chunks are a model over the footer
+    m_chunkModel = new ColumnChunkTableModel(this);
+    m_chunkView = new QTableView(this);
+    m_chunkView->setModel(m_chunkModel);
+    tabs->addTab(m_chunkView, "Column Chunks");
+
+    for (QTableView *table : {static_cast<QTableView *>(m_columnTable), m_chunkView}) {
+        table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        table->setAlternatingRowColors(true);
+        table->verticalHeader()->setVisible(false);
+        table->horizontalHeader()->setStretchLastSection(true);
+    }
+    mainLayout->addWidget(tabs);
+
+    m_progressBar = new QProgressBar(this);
+    mainLayout->addWidget(m_progressBar);
+    m_statusLabel = new QLabel("Decode throughput is measured per thread, with the column chunks already in memory.", this);
+    mainLayout->addWidget(m_statusLabel);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    buttonLayout->addStretch();
+
+    m_benchmarkButton = new QPushButton("Measure Decode Throughput", this);
+    connect(m_benchmarkButton, &QPushButton::clicked, this, &StorageLayoutDialog::runBenchmark);
+    buttonLayout->addWidget(m_benchmarkButton);
+
+    m_cancelButton = new QPushButton("Cancel", this);
+    connect(m_cancelButton, &QPushButton::clicked, this, &StorageLayoutDialog::cancelBenchmark);
+    buttonLayout->addWidget(m_cancelButton);
+
+    QPushButton *closeButton = new QPushButton("Close", this);
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::accept);
+    buttonLayout->addWidget(closeButton);
+
+    mainLayout->addLayout(buttonLayout);
+
+    setRunning(false);
+}
+
+StorageLayoutDialog::~StorageLayoutDialog() {
+    stopJob();
+}
+
+void StorageLayoutDialog::setTableModel(const ParquetTableModel *model) {
+    stopJob();
+    m_model = model;
+    m_progressBar->reset();
+    m_columnTable->setRowCount(0);
+    m_chunkModel->setFile(nullptr, false);
+    m_populated = false;
+    if (isVisible()) {
+        populateTables();
+    }
+    setRunning(false);
+}
+
+void StorageLayoutDialog::showEvent(QShowEvent *event) {
+    QDialog::showEvent(event);
+    if (!m_populated) {
+        populateTables();
+    }
+}
+
+void StorageLayoutDialog::populateTables() {
+    m_populated = true;
+    populateColumnTable();
+    if (m_model) {
+        m_chunkModel->setFile(m_model->getFileReader(), m_model->isRemote());
+    }
+    m_chunkView->resizeColumnsToContents();
+}
+
+void StorageLayoutDialog::populateColumnTable() {
+    m_columnTable->setRowCount(0);
+    std::shared_ptr<parquet::arrow::FileReader> reader = m_model ? m_model->getFileReader() : nullptr;
+    if (!reader) {
+        return;
+    }
+
+    auto metadata = reader->parquet_reader()->metadata();
+    std::shared_ptr<arrow::Schema> schema = m_model->getSchema();
+
+    struct ColumnTotals {
+        int field = 0;
+        qint64 compressed = 0;
+        qint64 uncompressed = 0;
+        QSet<QString> codecs;
+    };
+    std::vector<ColumnTotals> totals(schema->num_fields());
+    qint64 fileCompressed = 0;
+    std::vector<std::vector<int>> fieldLeaves(schema->num_fields());
+    for (int field = 0; field < schema->num_fields(); ++field) {
+        totals[field].field = field;
+        fieldLeaves[field] = m_model->columnIndicesForField(field);
+    }
+    for (int rowGroup = 0; rowGroup < metadata->num_row_groups(); ++rowGroup) {
+        auto rowGroupMetadata = metadata->RowGroup(rowGroup);
+        for (int field = 0; field < schema->num_fields(); ++field) {
+            for (int leaf : fieldLeaves[field]) {
+                auto chunk = rowGroupMetadata->ColumnChunk(leaf);
+                totals[field].compressed += chunk->total_compressed_size();
+                totals[field].uncompressed += chunk->total_uncompressed_size();
+                totals[field].codecs.insert(QString::fromStdString(arrow::util::Codec::GetCodecAsString(chunk->compression())));
+            }
+        }
+    }
+    for (const ColumnTotals &column : totals) {
+        fileCompressed += column.compressed;
+    }
+
+    // Largest columns first, as they dominate open and scroll latency
+    std::sort(totals.begin(), totals.end(), [](const ColumnTotals &a, const ColumnTotals &b) {
+        return a.compressed > b.compressed;
+    });
+
+    QLocale locale;
+    m_columnTable->setRowCount(static_cast<int>(totals.size()));
+    for (int row = 0; row < static_cast<int>(totals.size()); ++row) {
+        const ColumnTotals &column = totals[row];
+        std::shared_ptr<arrow::Field> field = schema->field(column.field);
+        QStringList codecs = column.codecs.values();
+        codecs.sort();
+
+        QTableWidgetItem *nameItem = readOnlyItem(QString::fromStdString(field->name()));
+        nameItem->setData(Qt::UserRole, column.field);
+        m_columnTable->setItem(row, ColumnName, nameItem);
+        m_columnTable->setItem(row, ColumnType, readOnlyItem(QString::fromStdString(field->type()->ToString())));
+        m_columnTable->setItem(row, ColumnCodecs, readOnlyItem(codecs.join(", ")));
+        m_columnTable->setItem(row, ColumnCompressed, readOnlyItem(formatSize(column.compressed)));
+        m_columnTable->setItem(row, ColumnUncompressed, readOnlyItem(formatSize(column.uncompressed)));
+        m_columnTable->setItem(row, ColumnRatio, readOnlyItem(column.compressed > 0
+            ? locale.toString(static_cast<double>(column.uncompressed) / column.compressed, 'f', 2) : QString("-")));
+        m_columnTable->setItem(row, ColumnShare, readOnlyItem(fileCompressed > 0
+            ? locale.toString(100.0 * column.compressed / fileCompressed, 'f', 1) + " %" : QString("-")));
+    }
+    m_columnTable->resizeColumnsToContents();
+}
+
+void StorageLayoutDialog::runBenchmark() {
+    if (!m_model || !m_model->getFileReader()) {
+        return;
+    }
+
+    stopJob();
+    m_job = new DecodeBenchmarkJob(m_model, this);
+    connect(m_job, &DecodeBenchmarkJob::progress, this, &StorageLayoutDialog::onProgress);
+    connect(m_job, &DecodeBenchmarkJob::finished, this, &StorageLayoutDialog::onFinished);
+    connect(m_job, &DecodeBenchmarkJob::failed, this, &StorageLayoutDialog::onFailed);
+
+    m_progressBar->setRange(0, m_model->getNumRowGroups());
+    m_progressBar->setValue(0);
+    m_statusLabel->setText("Decoding...");
+    setRunning(true);
+    m_job->start();
+}
+
+void StorageLayoutDialog::cancelBenchmark() {
+    if (!m_job) {
+        return;
+    }
+    m_job->cancel();
+    refreshBenchmarkResults();
+    m_statusLabel->setText("Benchmark cancelled, partial result.");
+    setRunning(false);
+}
+
+void StorageLayoutDialog::onProgress(int rowGroupsDone, int rowGroupsTotal) {
+    if (!BackgroundJob::isCurrent(m_job, sender())) {
+        return;
+    }
+    m_progressBar->setValue(rowGroupsDone);
+    m_statusLabel->setText(QString("Decoded %1 of %2 row groups").arg(rowGroupsDone).arg(rowGroupsTotal));
+    refreshBenchmarkResults();
+}
+
+void StorageLayoutDialog::onFinished() {
+    if (!BackgroundJob::isCurrent(m_job, sender())) {
+        return;
+    }
+    m_progressBar->setValue(m_progressBar->maximum());
+    refreshBenchmarkResults();
+    m_statusLabel->setText("Decode throughput is measured per thread, with the column chunks already in memory.");
+    setRunning(false);
+}
+
+void StorageLayoutDialog::onFailed(const QString &message) {
+    if (!BackgroundJob::isCurrent(m_job, sender())) {
+        return;
+    }
+    setRunning(false);
+    QMessageBox::critical(this, "Storage Layout", message);
+}
+
+void StorageLayoutDialog::refreshBenchmarkResults() {
+    if (!m_job) {
+        return;
+    }
+
+    QLocale locale;
+    QVector<ColumnDecodeStats> results = m_job->results();
+    for (int row = 0; row < m_columnTable->rowCount(); ++row) {
+        int field = m_columnTable->item(row, ColumnName)->data(Qt::UserRole).toInt();
+        const ColumnDecodeStats &stats = results[field];
+        if (stats.decodeSeconds <= 0.0) {
+            continue;
+        }
+        double megabytes = stats.uncompressedBytes / (1024.0 * 1024.0);
+        m_columnTable->setItem(row, ColumnDecodeSeconds, readOnlyItem(locale.toString(stats.decodeSeconds, 'f', 3)));
+        m_columnTable->setItem(row, ColumnDecodeMBps, readOnlyItem(locale.toString(megabytes / stats.decodeSeconds, 'f', 1)));
+        m_columnTable->setItem(row, ColumnDecodeRowsps, readOnlyItem(locale.toString(stats.rows / stats.decodeSeconds, 'f', 0)));
+    }
+}
+
+void StorageLayoutDialog::stopJob() {
+    BackgroundJob::retire(m_job);
+    m_job = nullptr;
+}
+
+void StorageLayoutDialog::setRunning(bool running) {
+    bool hasFile = m_model && m_model->getFileReader();
+    m_benchmarkButton->setEnabled(hasFile && !running);
+    m_cancelButton->setEnabled(running);
+}
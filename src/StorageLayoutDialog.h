@@ -0,0 +1,59 @@
+#ifndef STORAGELAYOUTDIALOG_H
+#define STORAGELAYOUTDIALOG_H
+
+#include <QDialog>
+#include <QLabel>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QTableView>
+#include <QTableWidget>
+
+#include "ColumnChunkTableModel.h"
+#include "DecodeBenchmarkJob.h"
+
+class ParquetTableModel;
+
+class StorageLayoutDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit StorageLayoutDialog(QWidget *parent = nullptr);
+    ~StorageLayoutDialog() override;
+
+    // Binds the dialog to the loaded file, cancelling any running benchmark. The layout tables are
+    // filled from the footer when the dialog is next shown.
+    void setTableModel(const ParquetTableModel *model);
+
+    // Cancels and waits for the running job; it must be stopped before the model is reloaded
+    void stopJob();
+
+protected:
+    void showEvent(QShowEvent *event) override;
+
+private slots:
+    void runBenchmark();
+    void cancelBenchmark();
+    void onProgress(int rowGroupsDone, int rowGroupsTotal);
+    void onFinished();
+    void onFailed(const QString &message);
+
+private:
+    void setRunning(bool running);
+    void populateTables();
+    void populateColumnTable();
+    void refreshBenchmarkResults();
+
+    const ParquetTableModel *m_model;
+    DecodeBenchmarkJob *m_job;
+    bool m_populated;
+
+    QTableWidget *m_columnTable;
+    QTableView *m_chunkView;
+    ColumnChunkTableModel *m_chunkModel;
+    QPushButton *m_benchmarkButton;
+    QPushButton *m_cancelButton;
+    QProgressBar *m_progressBar;
+    QLabel *m_statusLabel;
+};
+
+#endif // STORAGELAYOUTDIALOG_H
@@ -0,0 +1,231 @@
+#include "SummarizeDialog.h"
+#include "ParquetTableModel.h"
+
+// Undefine 'signals' macro from Qt to prevent conflict with arrow headers
+#undef signals
+#include <arrow/api.h>
+#include <arrow/type_traits.h>
+
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLocale>
+#include <QMessageBox>
+#include <QVBoxLayout>
+
+// Minimum time between progressive refreshes of the result table
+static constexpr int REFRESH_INTERVAL_MS = 250;
+
+SummarizeDialog::SummarizeDialog(QWidget *parent)
+    : QDialog(parent),
+      m_model(nullptr),
+      m_job(nullptr) {
+    setWindowTitle("Summarize");
+    setMinimumSize(800, 500);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    QHBoxLayout *topLayout = new QHBoxLayout();
+
+    m_keyList = new QListWidget(this);
+    m_valueList = new QListWidget(this);
+    m_topKSpinBox = new QSpinBox(this);
+    m_topKSpinBox->setRange(1, 100000);
+    m_topKSpinBox->setValue(100);
+
+    QFormLayout *optionsLayout = new QFormLayout();
+    optionsLayout->addRow("Group by:", m_keyList);
+    optionsLayout->addRow("Aggregate:", m_valueList);
+    optionsLayout->addRow("Top groups:", m_topKSpinBox);
+    topLayout->addLayout(optionsLayout, 1);
+
+    m_resultModel = new SummaryTableModel(this);
+    m_resultTable = new QTableView(this);
+    m_resultTable->setModel(m_resultModel);
+    m_resultTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_resultTable->setAlternatingRowColors(true);
+    m_resultTable->horizontalHeader()->setStretchLastSection(true);
+    topLayout->addWidget(m_resultTable, 3);
+
+    mainLayout->addLayout(topLayout);
+
+    m_progressBar = new QProgressBar(this);
+    mainLayout->addWidget(m_progressBar);
+    m_statusLabel = new QLabel(this);
+    mainLayout->addWidget(m_statusLabel);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    buttonLayout->addStretch();
+
+    m_runButton = new QPushButton("Run", this);
+    connect(m_runButton, &QPushButton::clicked, this, &SummarizeDialog::runSummary);
+    buttonLayout->addWidget(m_runButton);
+
+    m_cancelButton = new QPushButton("Cancel", this);
+    connect(m_cancelButton, &QPushButton::clicked, this, &SummarizeDialog::cancelSummary);
+    buttonLayout->addWidget(m_cancelButton);
+
+    QPushButton *closeButton = new QPushButton("Close", this);
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::accept);
+    buttonLayout->addWidget(closeButton);
+
+    mainLayout->addLayout(buttonLayout);
+
+    setRunning(false);
+}
+
+SummarizeDialog::~SummarizeDialog() {
+    stopJob();
+}
+
+void SummarizeDialog::setTableModel(const ParquetTableModel *model) {
+    stopJob();
+    m_model = model;
+
+    m_keyList->clear();
+    m_valueList->clear();
+    m_resultModel->clear();
+    m_progressBar->reset();
+    m_statusLabel->clear();
+
+    std::shared_ptr<arrow::Schema> schema = m_model ? m_model->getSchema() : nullptr;
+    if (schema) {
+        for (int i = 0; i < schema->num_fields(); ++i) {
+            std::shared_ptr<arrow::Field> field = schema->field(i);
+            QString label = QString("%1 (%2)")
+                                .arg(QString::fromStdString(field->name()))
+                                .arg(QString::fromStdString(field->type()->ToString()));
+
+            QListWidgetItem *keyItem = new QListWidgetItem(label, m_keyList);
+            keyItem->setFlags(keyItem->flags() | Qt::ItemIsUserCheckable);
+            keyItem->setCheckState(Qt::Unchecked);
+            keyItem->setData(Qt::UserRole, i);
+
+            // Only numeric columns can be summed and averaged
+            arrow::Type::type typeId = field->type()->id();
+            if (arrow::is_numeric(typeId) || arrow::is_decimal(typeId)) {
+                QListWidgetItem *valueItem = new QListWidgetItem(label, m_valueList);
+                valueItem->setFlags(valueItem->flags() | Qt::ItemIsUserCheckable);
+                valueItem->setCheckState(Qt::Unchecked);
+                valueItem->setData(Qt::UserRole, i);
+            }
+        }
+    }
+
+    setRunning(false);
+}
+
+void SummarizeDialog::runSummary() {
+    if (!m_model || !m_model->getFileReader()) {
+        return;
+    }
+
+    QVector<int> keyFields;
+    m_keyNames.clear();
+    for (int i = 0; i < m_keyList->count(); ++i) {
+        QListWidgetItem *item = m_keyList->item(i);
+        if (item->checkState() == Qt::Checked) {
+            int field = item->data(Qt::UserRole).toInt();
+            keyFields.append(field);
+            m_keyNames.append(QString::fromStdString(m_model->getSchema()->field(field)->name()));
+        }
+    }
+    if (keyFields.isEmpty()) {
+        QMessageBox::information(this, "Summarize", "Select at least one column to group by.");
+        return;
+    }
+
+    QVector<int> valueFields;
+    m_valueNames.clear();
+    for (int i = 0; i < m_valueList->count(); ++i) {
+        QListWidgetItem *item = m_valueList->item(i);
+        if (item->checkState() == Qt::Checked) {
+            int field = item->data(Qt::UserRole).toInt();
+            valueFields.append(field);
+            m_valueNames.append(QString::fromStdString(m_model->getSchema()->field(field)->name()));
+        }
+    }
+
+    stopJob();
+    m_job = new SummaryJob(m_model, keyFields, valueFields, this);
+    connect(m_job, &SummaryJob::progress, this, &SummarizeDialog::onProgress);
+    connect(m_job, &SummaryJob::finished, this, &SummarizeDialog::onFinished);
+    connect(m_job, &SummaryJob::failed, this, &SummarizeDialog::onFailed);
+
+    m_progressBar->setRange(0, m_model->getNumRowGroups());
+    m_progressBar->setValue(0);
+    m_resultModel->setColumns(m_keyNames, m_valueNames);
+    m_statusLabel->setText("Summarizing...");
+    m_refreshTimer.start();
+    setRunning(true);
+    refreshResults();
+
+    m_job->start();
+}
+
+void SummarizeDialog::cancelSummary() {
+    if (!m_job) {
+        return;
+    }
+    m_job->cancel();
+    refreshResults();
+    m_statusLabel->setText(m_statusLabel->text() + " (cancelled, partial result)");
+    setRunning(false);
+}
+
+void SummarizeDialog::onProgress(int rowGroupsDone, int rowGroupsTotal) {
+    if (!BackgroundJob::isCurrent(m_job, sender())) {
+        return;
+    }
+    m_progressBar->setValue(rowGroupsDone);
+    if (rowGroupsDone < rowGroupsTotal && m_refreshTimer.elapsed() < REFRESH_INTERVAL_MS) {
+        return;
+    }
+    m_refreshTimer.restart();
+    refreshResults();
+}
+
+void SummarizeDialog::onFinished() {
+    if (!BackgroundJob::isCurrent(m_job, sender())) {
+        return;
+    }
+    m_progressBar->setValue(m_progressBar->maximum());
+    refreshResults();
+    setRunning(false);
+}
+
+void SummarizeDialog::onFailed(const QString &message) {
+    if (!BackgroundJob::isCurrent(m_job, sender())) {
+        return;
+    }
+    setRunning(false);
+    QMessageBox::critical(this, "Summarize", message);
+}
+
+void SummarizeDialog::stopJob() {
+    BackgroundJob::retire(m_job);
+    m_job = nullptr;
+}
+
+void SummarizeDialog::refreshResults() {
+    if (!m_job) {
+        return;
+    }
+
+    QVector<SummaryGroup> groups = m_job->topGroups(m_topKSpinBox->value());
+    const int shown = groups.size();
+    m_resultModel->setGroups(std::move(groups));
+
+    QLocale locale;
+    m_statusLabel->setText(QString("%1 rows scanned, %2 groups, showing top %3")
+                               .arg(locale.toString(m_job->rowsScanned()))
+                               .arg(locale.toString(m_job->groupCount()))
+                               .arg(shown));
+}
+
+void SummarizeDialog::setRunning(bool running) {
+    bool hasFile = m_model && m_model->getFileReader();
+    m_runButton->setEnabled(hasFile && !running);
+    m_cancelButton->setEnabled(running);
+    m_keyList->setEnabled(!running);
+    m_valueList->setEnabled(!running);
+}
@@ -0,0 +1,59 @@
+#ifndef SUMMARIZEDIALOG_H
+#define SUMMARIZEDIALOG_H
+
+#include <QDialog>
+#include <QElapsedTimer>
+#include <QLabel>
+#include <QListWidget>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTableView>
+
+#include "SummaryJob.h"
+#include "SummaryTableModel.h"
+
+class ParquetTableModel;
+
+class SummarizeDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit SummarizeDialog(QWidget *parent = nullptr);
+    ~SummarizeDialog() override;
+
+    // Binds the dialog to the currently loaded file, cancelling any running summary
+    void setTableModel(const ParquetTableModel *model);
+
+    // Cancels and waits for the running job; it must be stopped before the model is reloaded
+    void stopJob();
+
+private slots:
+    void runSummary();
+    void cancelSummary();
+    void onProgress(int rowGroupsDone, int rowGroupsTotal);
+    void onFinished();
+    void onFailed(const QString &message);
+
+private:
+    void refreshResults();
+    void setRunning(bool running);
+
+    const ParquetTableModel *m_model;
+    SummaryJob *m_job;
+    QStringList m_keyNames;
+    QStringList m_valueNames;
+    QElapsedTimer m_refreshTimer;
+
+    QListWidget *m_keyList;
+    QListWidget *m_valueList;
+    QSpinBox *m_topKSpinBox;
+    QPushButton *m_runButton;
+    QPushButton *m_cancelButton;
+    QProgressBar *m_progressBar;
+    QLabel *m_statusLabel;
+    SummaryTableModel *m_resultModel;
+    QTableView *m_resultTable;
+};
+
+#endif // SUMMARIZEDIALOG_H
@@ -0,0 +1,250 @@
+#include "SummaryJob.h"
+#include "ParquetTableModel.h"
+
+// Undefine 'signals' macro from Qt to prevent conflict with arrow headers
+#undef signals
+#include <arrow/api.h>
+#include <arrow/compute/cast.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/file_reader.h>
+
+#include <QDebug>
+
+#include <algorithm>
+#include <limits>
+#include <string_view>
+
+// Check for cancellation every this many rows inside a row group
+static constexpr int64_t CANCEL_CHECK_INTERVAL = 65536;
+
+SummaryJob::SummaryJob(const ParquetTableModel *model, const QVector<int> &keyFields,
+                       const QVector<int> &valueFields, QObject *parent)
+    : BackgroundJob(parent),
+      m_model(model),
+      m_keyFields(keyFields),
+      m_valueFields(valueFields),
+      m_numRowGroups(model->getNumRowGroups()),
+      m_rowGroupsDone(0),
+      m_rowsScanned(0)
+{
+    // Only the key and value columns are ever read
+    std::vector<int> fields;
+    for (int field : m_keyFields) {
+        fields.push_back(field);
+    }
+    for (int field : m_valueFields) {
+        fields.push_back(field);
+    }
+    std::sort(fields.begin(), fields.end());
+    fields.erase(std::unique(fields.begin(), fields.end()), fields.end());
+    for (int field : fields) {
+        std::vector<int> leaves = model->columnIndicesForField(field);
+        m_columnIndices.insert(m_columnIndices.end(), leaves.begin(), leaves.end());
+    }
+
+    // The tables read hold the fields in schema order, so columns are found by position; names
+    // may be duplicated
+    auto schema = model->getSchema();
+    auto position = [&fields](int field) {
+        return static_cast<int>(std::lower_bound(fields.begin(), fields.end(), field) - fields.begin());
+    };
+    for (int field : m_keyFields) {
+        m_keyNames.push_back(schema->field(field)->name());
+        m_keyColumns.push_back(position(field));
+    }
+    for (int field : m_valueFields) {
+        m_valueNames.push_back(schema->field(field)->name());
+        m_valueColumns.push_back(position(field));
+    }
+}
+
+SummaryJob::~SummaryJob() {
+    stopTasks();
+}
+
+void SummaryJob::start() {
+    if (m_numRowGroups == 0) {
+        emit finished();
+        return;
+    }
+
+    for (int rowGroup = 0; rowGroup < m_numRowGroups; ++rowGroup) {
+        m_pool.start([this, rowGroup]() {
+            parquet::arrow::FileReader *reader = threadReader(m_model);
+            if (!reader) {
+                fail("Could not open a reader for the Parquet file.");
+                return;
+            }
+            aggregateRowGroup(rowGroup, *reader);
+        });
+    }
+}
+
+void SummaryJob::aggregateRowGroup(int rowGroup, parquet::arrow::FileReader &reader) {
+    if (isCancelled()) {
+        return;
+    }
+
+    std::shared_ptr<arrow::Table> table;
+    arrow::Status status = reader.ReadRowGroup(rowGroup, m_columnIndices, &table);
+    if (!status.ok()) {
+        fail(QString("Failed to read row group %1: %2").arg(rowGroup).arg(status.ToString().c_str()));
+        return;
+    }
+    arrow::Result<std::shared_ptr<arrow::Table>> combined = table->CombineChunks();
+    if (!combined.ok()) {
+        fail(QString("Failed to combine row group %1: %2").arg(rowGroup).arg(combined.status().ToString().c_str()));
+        return;
+    }
+    table = *combined;
+
+    const int64_t numRows = table->num_rows();
+    AggregateMap partial;
+
+    if (numRows > 0) {
+        // Normalise keys to strings and values to doubles so a single aggregation loop handles every type
+        std::vector<std::shared_ptr<arrow::LargeStringArray>> keyArrays;
+        for (size_t k = 0; k < m_keyColumns.size(); ++k) {
+            auto cast = arrow::compute::Cast(table->column(m_keyColumns[k]), arrow::large_utf8(),
+                                             arrow::compute::CastOptions::Unsafe());
+            if (!cast.ok()) {
+                fail(QString("Cannot group by column '%1': %2").arg(QString::fromStdString(m_keyNames[k])).arg(cast.status().ToString().c_str()));
+                return;
+            }
+            keyArrays.push_back(std::static_pointer_cast<arrow::LargeStringArray>(cast->chunked_array()->chunk(0)));
+        }
+
+        std::vector<std::shared_ptr<arrow::DoubleArray>> valueArrays;
+        for (size_t v = 0; v < m_valueColumns.size(); ++v) {
+            auto cast = arrow::compute::Cast(table->column(m_valueColumns[v]), arrow::float64(),
+                                             arrow::compute::CastOptions::Unsafe());
+            if (!cast.ok()) {
+                fail(QString("Cannot aggregate column '%1': %2").arg(QString::fromStdString(m_valueNames[v])).arg(cast.status().ToString().c_str()));
+                return;
+            }
+            valueArrays.push_back(std::static_pointer_cast<arrow::DoubleArray>(cast->chunked_array()->chunk(0)));
+        }
+
+        const size_t numValues = valueArrays.size();
+        std::string composite;
+        for (int64_t row = 0; row < numRows; ++row) {
+            if (row % CANCEL_CHECK_INTERVAL == 0 && isCancelled()) {
+                return;
+            }
+
+            // Length-prefixed composite key, so nulls, empty strings and separators never collide
+            composite.clear();
+            for (const auto &keys : keyArrays) {
+                if (keys->IsNull(row)) {
+                    composite.push_back('\0');
+                    continue;
+                }
+                std::string_view value = keys->GetView(row);
+                uint64_t length = value.size();
+                composite.push_back('\1');
+                composite.append(reinterpret_cast<const char *>(&length), sizeof(length));
+                composite.append(value);
+            }
+
+            auto [it, inserted] = partial.try_emplace(composite);
+            Aggregate &aggregate = it->second;
+            if (inserted) {
+                for (const auto &keys : keyArrays) {
+                    aggregate.keys.push_back(keys->IsNull(row) ? std::string("<NULL>") : std::string(keys->GetView(row)));
+                }
+                aggregate.valueCounts.assign(numValues, 0);
+                aggregate.sums.assign(numValues, 0.0);
+                aggregate.mins.assign(numValues, std::numeric_limits<double>::infinity());
+                aggregate.maxs.assign(numValues, -std::numeric_limits<double>::infinity());
+            }
+
+            ++aggregate.count;
+            for (size_t v = 0; v < numValues; ++v) {
+                if (valueArrays[v]->IsNull(row)) {
+                    continue;
+                }
+                double value = valueArrays[v]->Value(row);
+                ++aggregate.valueCounts[v];
+                aggregate.sums[v] += value;
+                aggregate.mins[v] = std::min(aggregate.mins[v], value);
+                aggregate.maxs[v] = std::max(aggregate.maxs[v], value);
+            }
+        }
+    }
+
+    if (isCancelled()) {
+        return;
+    }
+    mergePartial(std::move(partial), numRows);
+
+    int done = ++m_rowGroupsDone;
+    emit progress(done, m_numRowGroups);
+    if (done == m_numRowGroups) {
+        emit finished();
+    }
+}
+
+void SummaryJob::mergePartial(AggregateMap &&partial, qint64 rows) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_rowsScanned += rows;
+    for (auto &[key, aggregate] : partial) {
+        auto [it, inserted] = m_groups.try_emplace(key);
+        if (inserted) {
+            it->second = std::move(aggregate);
+            continue;
+        }
+        Aggregate &merged = it->second;
+        merged.count += aggregate.count;
+        for (size_t v = 0; v < merged.sums.size(); ++v) {
+            merged.valueCounts[v] += aggregate.valueCounts[v];
+            merged.sums[v] += aggregate.sums[v];
+            merged.mins[v] = std::min(merged.mins[v], aggregate.mins[v]);
+            merged.maxs[v] = std::max(merged.maxs[v], aggregate.maxs[v]);
+        }
+    }
+}
+
+QVector<SummaryGroup> SummaryJob::topGroups(int k) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<const Aggregate *> ranked;
+    ranked.reserve(m_groups.size());
+    for (const auto &entry : m_groups) {
+        ranked.push_back(&entry.second);
+    }
+    size_t limit = std::min(ranked.size(), static_cast<size_t>(std::max(k, 0)));
+    std::partial_sort(ranked.begin(), ranked.begin() + limit, ranked.end(),
+                      [](const Aggregate *a, const Aggregate *b) {
+                          if (a->count != b->count) {
+                              return a->count > b->count;
+                          }
+                          return a->keys < b->keys;
+                      });
+
+    QVector<SummaryGroup> groups;
+    groups.reserve(static_cast<qsizetype>(limit));
+    for (size_t i = 0; i < limit; ++i) {
+        const Aggregate *aggregate = ranked[i];
+        SummaryGroup group;
+        for (const std::string &key : aggregate->keys) {
+            group.keys.append(QString::fromStdString(key));
+        }
+        group.count = aggregate->count;
+        group.valueCounts = QVector<qint64>(aggregate->valueCounts.begin(), aggregate->valueCounts.end());
+        group.sums = QVector<double>(aggregate->sums.begin(), aggregate->sums.end());
+        group.mins = QVector<double>(aggregate->mins.begin(), aggregate->mins.end());
+        group.maxs = QVector<double>(aggregate->maxs.begin(), aggregate->maxs.end());
+        groups.append(group);
+    }
+    return groups;
+}
+
+qint64 SummaryJob::groupCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<qint64>(m_groups.size());
+}
+
+qint64 SummaryJob::rowsScanned() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_rowsScanned;
+}
@@ -0,0 +1,80 @@
+#ifndef SUMMARYJOB_H
+#define SUMMARYJOB_H
+
+#include "BackgroundJob.h"
+
+#include <QStringList>
+#include <QVector>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ParquetTableModel;
+namespace parquet {
+    namespace arrow {
+        class FileReader;
+    }
+}
+
+// One group of the summary, as handed to the UI
+struct SummaryGroup {
+    QStringList keys;
+    qint64 count = 0;
+    QVector<qint64> valueCounts; // Non-null values per value column
+    QVector<double> sums;
+    QVector<double> mins;
+    QVector<double> maxs;
+};
+
+// Group-by aggregation over a Parquet file.
+// Every row group is aggregated into a partial result on its own pool thread, reading only the
+// key and value columns, and the partials are merged under a lock as they complete.
+class SummaryJob : public BackgroundJob {
+    Q_OBJECT
+
+public:
+    SummaryJob(const ParquetTableModel *model, const QVector<int> &keyFields,
+               const QVector<int> &valueFields, QObject *parent = nullptr);
+    ~SummaryJob() override;
+
+    void start() override;
+
+    // Snapshot of the merged result so far: the K groups with the highest counts
+    QVector<SummaryGroup> topGroups(int k) const;
+    qint64 groupCount() const;
+    qint64 rowsScanned() const;
+
+private:
+    struct Aggregate {
+        std::vector<std::string> keys;
+        qint64 count = 0;
+        std::vector<qint64> valueCounts;
+        std::vector<double> sums;
+        std::vector<double> mins;
+        std::vector<double> maxs;
+    };
+    using AggregateMap = std::unordered_map<std::string, Aggregate>;
+
+    void aggregateRowGroup(int rowGroup, parquet::arrow::FileReader &reader);
+    void mergePartial(AggregateMap &&partial, qint64 rows);
+
+    const ParquetTableModel *m_model;
+    QVector<int> m_keyFields;
+    QVector<int> m_valueFields;
+    std::vector<std::string> m_keyNames;
+    std::vector<std::string> m_valueNames;
+    std::vector<int> m_keyColumns;   // Position of every key field in the tables read
+    std::vector<int> m_valueColumns; // Position of every value field in the tables read
+    std::vector<int> m_columnIndices;
+    int m_numRowGroups;
+
+    std::atomic<int> m_rowGroupsDone;
+
+    mutable std::mutex m_mutex;
+    AggregateMap m_groups;
+    qint64 m_rowsScanned;
+};
+
+#endif // SUMMARYJOB_H
@@ -0,0 +1,115 @@
+#include "SummaryTableModel.h"
+
+#include <QLocale>
+
+#include <algorithm>
+
+// Aggregates shown for every value column, in column order
+static constexpr int AGGREGATES_PER_VALUE = 4;
+
+SummaryTableModel::SummaryTableModel(QObject *parent)
+    : QAbstractTableModel(parent),
+      m_numKeys(0)
+{
+}
+
+void SummaryTableModel::setColumns(const QStringList &keyNames, const QStringList &valueNames) {
+    beginResetModel();
+    m_headers = keyNames;
+    m_headers.append("Count");
+    for (const QString &name : valueNames) {
+        m_headers.append(QString("sum(%1)").arg(name));
+        m_headers.append(QString("min(%1)").arg(name));
+        m_headers.append(QString("max(%1)").arg(name));
+        m_headers.append(QString("mean(%1)").arg(name));
+    }
+    m_numKeys = keyNames.size();
+    m_groups.clear();
+    endResetModel();
+}
+
+void SummaryTableModel::setGroups(QVector<SummaryGroup> groups) {
+    // Only the row count changes between snapshots of one summary, so the view keeps its scroll
+    // position and selection
+    const int oldRows = m_groups.size();
+    const int newRows = groups.size();
+    if (newRows < oldRows) {
+        beginRemoveRows(QModelIndex(), newRows, oldRows - 1);
+        m_groups = std::move(groups);
+        endRemoveRows();
+    } else if (newRows > oldRows) {
+        beginInsertRows(QModelIndex(), oldRows, newRows - 1);
+        m_groups = std::move(groups);
+        endInsertRows();
+    } else {
+        m_groups = std::move(groups);
+    }
+    if (oldRows > 0 && newRows > 0 && !m_headers.isEmpty()) {
+        emit dataChanged(index(0, 0), index(std::min(oldRows, newRows) - 1, m_headers.size() - 1),
+                         {Qt::DisplayRole});
+    }
+}
+
+void SummaryTableModel::clear() {
+    beginResetModel();
+    m_headers.clear();
+    m_numKeys = 0;
+    m_groups.clear();
+    endResetModel();
+}
+
+int SummaryTableModel::rowCount(const QModelIndex &parent) const {
+    if (parent.isValid()) {
+        return 0;
+    }
+    return m_groups.size();
+}
+
+int SummaryTableModel::columnCount(const QModelIndex &parent) const {
+    if (parent.isValid()) {
+        return 0;
+    }
+    return m_headers.size();
+}
+
+QVariant SummaryTableModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || role != Qt::DisplayRole || index.row() >= m_groups.size()) {
+        return QVariant();
+    }
+
+    const SummaryGroup &group = m_groups[index.row()];
+    int column = index.column();
+    if (column < m_numKeys) {
+        return column < group.keys.size() ? group.keys[column] : QVariant();
+    }
+
+    QLocale locale;
+    if (column == m_numKeys) {
+        return locale.toString(group.count);
+    }
+
+    int value = (column - m_numKeys - 1) / AGGREGATES_PER_VALUE;
+    if (value >= group.sums.size()) {
+        return QVariant();
+    }
+    if (group.valueCounts[value] == 0) {
+        return "<NULL>";
+    }
+    switch ((column - m_numKeys - 1) % AGGREGATES_PER_VALUE) {
+    case 0:
+        return locale.toString(group.sums[value], 'g', 15);
+    case 1:
+        return locale.toString(group.mins[value], 'g', 15);
+    case 2:
+        return locale.toString(group.maxs[value], 'g', 15);
+    default:
+        return locale.toString(group.sums[value] / static_cast<double>(group.valueCounts[value]), 'g', 15);
+    }
+}
+
+QVariant SummaryTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+    return m_headers.value(section);
+}
@@ -0,0 +1,37 @@
+#ifndef SUMMARYTABLEMODEL_H
+#define SUMMARYTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QStringList>
+#include <QVector>
+
+#include "SummaryJob.h"
+
+// The top groups of a summary, one row per group: the keys, the count, then sum, min, max and mean
+// of every value column.
+// Holds the latest snapshot from SummaryJob::topGroups and formats cells on demand for the rows the
+// view asks for, so progressive refreshes cost the same however many groups are shown.
+class SummaryTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    explicit SummaryTableModel(QObject *parent = nullptr);
+
+    // Starts a new summary with these key and value columns, and no groups
+    void setColumns(const QStringList &keyNames, const QStringList &valueNames);
+    // Replaces the groups shown with a newer snapshot
+    void setGroups(QVector<SummaryGroup> groups);
+    void clear();
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    QStringList m_headers;
+    int m_numKeys;
+    QVector<SummaryGroup> m_groups;
+};
+
+#endif // SUMMARYTABLEMODEL_H
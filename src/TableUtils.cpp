@@ -0,0 +1,9 @@
+#include "TableUtils.h"
+
+#include <QTableWidgetItem>
+
+QTableWidgetItem *readOnlyItem(const QString &text) {
+    QTableWidgetItem *item = new QTableWidgetItem(text);
+    item->setFlags(item->flags() & ~Qt::ItemIsEditable);
+    return item;
+}
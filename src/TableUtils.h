@@ -0,0 +1,11 @@
+#ifndef TABLEUTILS_H
+#define TABLEUTILS_H
+
+#include <QString>
+
+class QTableWidgetItem;
+
+// Table cell that can be selected and copied but not edited
+QTableWidgetItem *readOnlyItem(const QString &text);
+
+#endif // TABLEUTILS_H
@@ -1,17 +1,52 @@
 #include <QApplication>
+#include <QDebug>
 #include <QIcon>
+#include <QMessageBox>
 #include "MainWindow.h"
 
+// Undefine 'signals' macro from Qt to prevent conflict with arrow headers
+#undef signals
+#include <arrow/util/config.h>
+#if ARROW_VERSION_MAJOR >= 21
+#include <arrow/compute/initialize.h>
+#endif
+#ifdef ARROW_S3
+#include <arrow/filesystem/s3fs.h>
+#endif
+
 int main(int argc, char *argv[]) {
     QApplication a(argc, argv);
     a.setWindowIcon(QIcon(":/icons/app_icon.png"));
-    MainWindow w;
 
-    // Handle command line argument for opening a file
-    if (argc > 1) {
-        w.openFile(argv[1]);
+#if ARROW_VERSION_MAJOR >= 21
+    // Register the kernels of the separate compute library used by the summary view
+    arrow::Status compute_status = arrow::compute::Initialize();
+    if (!compute_status.ok()) {
+        qCritical() << "Error initializing Arrow compute:" << compute_status.ToString().c_str();
+        QMessageBox::critical(nullptr, "ParquetPad",
+                              QString("Could not initialize Arrow compute: %1").arg(compute_status.ToString().c_str()));
+        return 1;
+    }
+#endif
+
+    int result;
+    {
+        MainWindow w;
+
+        // Handle command line argument for opening a file or URL
+        if (argc > 1) {
+            w.openFile(argv[1]);
+        }
+
+        w.show();
+        result = a.exec();
     }
 
-    w.show();
-    return a.exec();
+#ifdef ARROW_S3
+    // S3 must be finalized after every S3 file has been closed, i.e. after the window is gone
+    if (!arrow::fs::FinalizeS3().ok()) {
+        return 1;
+    }
+#endif
+    return result;
 }
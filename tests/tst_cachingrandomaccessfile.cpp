@@ -0,0 +1,327 @@
+#include "CachingRandomAccessFile.h"
+
+// Undefine 'signals' macro from Qt to prevent conflict with arrow headers
+#undef signals
+#include <arrow/buffer.h>
+#include <arrow/io/file.h>
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QRandomGenerator>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include <utility>
+#include <vector>
+
+// Passes reads through to a local file, recording every ranged read. With refuseReads set it fails
+// them instead, so a test can tell that data came from the cache.
+class RecordingFile : public arrow::io::RandomAccessFile {
+public:
+    explicit RecordingFile(std::shared_ptr<arrow::io::RandomAccessFile> inner) : m_inner(std::move(inner)) {}
+
+    std::vector<std::pair<qint64, qint64>> reads;
+    bool refuseReads = false;
+
+    arrow::Status Close() override { return m_inner->Close(); }
+    bool closed() const override { return m_inner->closed(); }
+    arrow::Result<int64_t> Tell() const override { return m_inner->Tell(); }
+    arrow::Status Seek(int64_t position) override { return m_inner->Seek(position); }
+    arrow::Result<int64_t> Read(int64_t nbytes, void *out) override { return m_inner->Read(nbytes, out); }
+    arrow::Result<std::shared_ptr<arrow::Buffer>> Read(int64_t nbytes) override { return m_inner->Read(nbytes); }
+    arrow::Result<int64_t> GetSize() override { return m_inner->GetSize(); }
+
+    arrow::Result<int64_t> ReadAt(int64_t position, int64_t nbytes, void *out) override {
+        ARROW_RETURN_NOT_OK(record(position, nbytes));
+        return m_inner->ReadAt(position, nbytes, out);
+    }
+
+    arrow::Result<std::shared_ptr<arrow::Buffer>> ReadAt(int64_t position, int64_t nbytes) override {
+        ARROW_RETURN_NOT_OK(record(position, nbytes));
+        return m_inner->ReadAt(position, nbytes);
+    }
+
+private:
+    arrow::Status record(int64_t position, int64_t nbytes) {
+        if (refuseReads) {
+            return arrow::Status::IOError("Read past the cache");
+        }
+        reads.emplace_back(position, nbytes);
+        return arrow::Status::OK();
+    }
+
+    std::shared_ptr<arrow::io::RandomAccessFile> m_inner;
+};
+
+class TestCachingRandomAccessFile : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    // First, while the cache index holds nothing but the leftover blocks written by initTestCase()
+    void replacedBlocksAccounted();
+    void readsMatchSource_data();
+    void readsMatchSource();
+    void missingBlocksFetchedInOneRead();
+    void partialBlockFetchedAgain();
+    void credentialsLeftOutOfCache();
+    void openFilesNotEvicted();
+    void leastRecentlyUsedEvicted();
+
+private:
+    static constexpr qint64 BLOCK = CachingRandomAccessFile::CACHE_BLOCK_SIZE;
+    // Three and a half blocks plus a few bytes, so the last block is short
+    static constexpr qint64 FILE_SIZE = 3 * BLOCK + BLOCK / 2 + 123;
+    static constexpr int NUM_BLOCKS = 4;
+
+    std::string newCacheDirectory();
+    std::shared_ptr<RecordingFile> openSource();
+    QByteArray readRange(CachingRandomAccessFile &file, qint64 position, qint64 length);
+    // Opens a new cache directory and reads the whole file through it, so every block that fits is cached
+    std::unique_ptr<CachingRandomAccessFile> openAndFill(std::string &cacheDirectory);
+    int cachedBlocks(const std::string &cacheDirectory);
+    qint64 diskUsage();
+
+    QTemporaryDir m_tempDir;
+    QString m_sourcePath;
+    QByteArray m_contents;
+    int m_cacheDirectories = 0;
+    std::string m_leftoverDirectory;
+};
+
+void TestCachingRandomAccessFile::initTestCase() {
+    QStandardPaths::setTestModeEnabled(true);
+    QVERIFY(m_tempDir.isValid());
+
+    m_contents.resize(FILE_SIZE);
+    QRandomGenerator generator(42);
+    for (char &byte : m_contents) {
+        byte = static_cast<char>(generator.bounded(256));
+    }
+    m_sourcePath = m_tempDir.filePath("source.bin");
+    QFile source(m_sourcePath);
+    QVERIFY(source.open(QIODevice::WriteOnly));
+    QCOMPARE(source.write(m_contents), FILE_SIZE);
+    source.close();
+
+    // Short blocks left by an earlier run, on disk before the cache index is first built
+    m_leftoverDirectory = newCacheDirectory();
+    const QString leftover = QString::fromStdString(m_leftoverDirectory);
+    QFile first(leftover + "/0");
+    QVERIFY(first.open(QIODevice::WriteOnly));
+    QCOMPARE(first.write(m_contents.left(100)), qint64(100));
+    QFile last(leftover + "/3");
+    QVERIFY(last.open(QIODevice::WriteOnly));
+    QCOMPARE(last.write(m_contents.mid(3 * BLOCK, 10)), qint64(10));
+}
+
+void TestCachingRandomAccessFile::cleanupTestCase() {
+    QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).removeRecursively();
+}
+
+std::string TestCachingRandomAccessFile::newCacheDirectory() {
+    // A distinct URI per call gives every test a cold cache
+    std::string uri = "s3://bucket/test-" + std::to_string(++m_cacheDirectories) + ".bin";
+    return CachingRandomAccessFile::cacheDirectoryFor(uri, FILE_SIZE, 0);
+}
+
+std::shared_ptr<RecordingFile> TestCachingRandomAccessFile::openSource() {
+    auto file = arrow::io::ReadableFile::Open(m_sourcePath.toStdString());
+    if (!file.ok()) {
+        return nullptr;
+    }
+    return std::make_shared<RecordingFile>(*file);
+}
+
+std::unique_ptr<CachingRandomAccessFile> TestCachingRandomAccessFile::openAndFill(std::string &cacheDirectory) {
+    cacheDirectory = newCacheDirectory();
+    std::shared_ptr<RecordingFile> source = openSource();
+    if (!source) {
+        return nullptr;
+    }
+    auto file = std::make_unique<CachingRandomAccessFile>(source, FILE_SIZE, cacheDirectory);
+    if (readRange(*file, 0, FILE_SIZE) != m_contents) {
+        return nullptr;
+    }
+    return file;
+}
+
+int TestCachingRandomAccessFile::cachedBlocks(const std::string &cacheDirectory) {
+    int blocks = 0;
+    for (int block = 0; block < NUM_BLOCKS; ++block) {
+        QFileInfo info(QString::fromStdString(cacheDirectory) + "/" + QString::number(block));
+        if (info.exists() && info.size() == std::min(BLOCK, FILE_SIZE - block * BLOCK)) {
+            ++blocks;
+        }
+    }
+    return blocks;
+}
+
+qint64 TestCachingRandomAccessFile::diskUsage() {
+    const QString root = QFileInfo(QString::fromStdString(m_leftoverDirectory)).path();
+    qint64 size = 0;
+    QDirIterator it(root, QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        size += it.fileInfo().size();
+    }
+    return size;
+}
+
+QByteArray TestCachingRandomAccessFile::readRange(CachingRandomAccessFile &file, qint64 position, qint64 length) {
+    auto buffer = file.ReadAt(position, length);
+    if (!buffer.ok()) {
+        qWarning() << "Read failed:" << buffer.status().ToString().c_str();
+        return QByteArray();
+    }
+    return QByteArray(reinterpret_cast<const char *>((*buffer)->data()), static_cast<qsizetype>((*buffer)->size()));
+}
+
+void TestCachingRandomAccessFile::readsMatchSource_data() {
+    QTest::addColumn<qint64>("position");
+    QTest::addColumn<qint64>("length");
+
+    QTest::newRow("within first block") << qint64(100) << qint64(1000);
+    QTest::newRow("exactly one block") << BLOCK << BLOCK;
+    QTest::newRow("across one boundary") << BLOCK - 10 << qint64(20);
+    QTest::newRow("across several boundaries") << BLOCK / 2 << 2 * BLOCK + 7;
+    QTest::newRow("into short last block") << 3 * BLOCK - 5 << qint64(100);
+    QTest::newRow("whole file") << qint64(0) << FILE_SIZE;
+    QTest::newRow("past end of file") << FILE_SIZE - 50 << qint64(1000);
+}
+
+void TestCachingRandomAccessFile::readsMatchSource() {
+    QFETCH(qint64, position);
+    QFETCH(qint64, length);
+    const QByteArray expected = m_contents.mid(position, length);
+    const std::string cacheDirectory = newCacheDirectory();
+
+    // Cold cache: the blocks come from the source and are written to the cache
+    std::shared_ptr<RecordingFile> cold = openSource();
+    QVERIFY(cold);
+    {
+        CachingRandomAccessFile file(cold, FILE_SIZE, cacheDirectory);
+        QCOMPARE(readRange(file, position, length), expected);
+    }
+    QVERIFY(!cold->reads.empty());
+    for (const auto &[start, size] : cold->reads) {
+        QCOMPARE(start % BLOCK, qint64(0));
+        QVERIFY(size % BLOCK == 0 || start + size == FILE_SIZE);
+    }
+
+    // Warm cache: the same bytes come from the cache alone
+    std::shared_ptr<RecordingFile> warm = openSource();
+    QVERIFY(warm);
+    warm->refuseReads = true;
+    CachingRandomAccessFile file(warm, FILE_SIZE, cacheDirectory);
+    QCOMPARE(readRange(file, position, length), expected);
+}
+
+void TestCachingRandomAccessFile::missingBlocksFetchedInOneRead() {
+    const std::string cacheDirectory = newCacheDirectory();
+    std::shared_ptr<RecordingFile> source = openSource();
+    QVERIFY(source);
+    CachingRandomAccessFile file(source, FILE_SIZE, cacheDirectory);
+    QCOMPARE(readRange(file, 0, FILE_SIZE), m_contents);
+
+    // Blocks 1 and 2 form one run of missing blocks between cached ones
+    QVERIFY(QFile::remove(QString::fromStdString(cacheDirectory) + "/1"));
+    QVERIFY(QFile::remove(QString::fromStdString(cacheDirectory) + "/2"));
+    source->reads.clear();
+    QCOMPARE(readRange(file, 10, FILE_SIZE - 20), m_contents.mid(10, FILE_SIZE - 20));
+    QCOMPARE(source->reads.size(), size_t(1));
+    QCOMPARE(source->reads[0].first, BLOCK);
+    QCOMPARE(source->reads[0].second, 2 * BLOCK);
+}
+
+void TestCachingRandomAccessFile::partialBlockFetchedAgain() {
+    const std::string cacheDirectory = newCacheDirectory();
+    std::shared_ptr<RecordingFile> source = openSource();
+    QVERIFY(source);
+    CachingRandomAccessFile file(source, FILE_SIZE, cacheDirectory);
+    QCOMPARE(readRange(file, 0, FILE_SIZE), m_contents);
+
+    // A truncated block, as left by an interrupted write, must not be served
+    const QString lastBlock = QString::fromStdString(cacheDirectory) + "/3";
+    QVERIFY(QFile::resize(lastBlock, 100));
+    source->reads.clear();
+    QCOMPARE(readRange(file, 3 * BLOCK, FILE_SIZE - 3 * BLOCK), m_contents.mid(3 * BLOCK));
+    QCOMPARE(source->reads.size(), size_t(1));
+    QCOMPARE(source->reads[0].first, 3 * BLOCK);
+    QCOMPARE(QFileInfo(lastBlock).size(), FILE_SIZE - 3 * BLOCK);
+}
+
+void TestCachingRandomAccessFile::credentialsLeftOutOfCache() {
+    const std::string withCredentials =
+        CachingRandomAccessFile::cacheDirectoryFor("s3://KEY:SECRET@bucket/data.parquet", FILE_SIZE, 0);
+    const std::string without = CachingRandomAccessFile::cacheDirectoryFor("s3://bucket/data.parquet", FILE_SIZE, 0);
+    QCOMPARE(withCredentials, without);
+
+    QDirIterator it(QString::fromStdString(withCredentials), QDir::Files | QDir::Hidden);
+    while (it.hasNext()) {
+        QFile file(it.next());
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QVERIFY(!file.readAll().contains("SECRET"));
+    }
+}
+
+void TestCachingRandomAccessFile::replacedBlocksAccounted() {
+    // The index counts the short blocks from disk; replacing them must count only the difference
+    const qint64 indexBefore = CachingRandomAccessFile::cachedBytes();
+    const qint64 diskBefore = diskUsage();
+    QCOMPARE(indexBefore, diskBefore);
+
+    std::shared_ptr<RecordingFile> source = openSource();
+    QVERIFY(source);
+    {
+        CachingRandomAccessFile file(source, FILE_SIZE, m_leftoverDirectory);
+        QCOMPARE(readRange(file, 0, FILE_SIZE), m_contents);
+    }
+    QCOMPARE(cachedBlocks(m_leftoverDirectory), NUM_BLOCKS);
+    QCOMPARE(diskUsage() - diskBefore, FILE_SIZE - 110);
+    QCOMPARE(CachingRandomAccessFile::cachedBytes() - indexBefore, diskUsage() - diskBefore);
+}
+
+void TestCachingRandomAccessFile::openFilesNotEvicted() {
+    // Two open files take 7 MiB of the 8 MiB cap, and closed files are evicted to make room for them
+    std::string first;
+    std::string second;
+    std::unique_ptr<CachingRandomAccessFile> firstFile = openAndFill(first);
+    std::unique_ptr<CachingRandomAccessFile> secondFile = openAndFill(second);
+    QVERIFY(firstFile && secondFile);
+    QCOMPARE(cachedBlocks(first), NUM_BLOCKS);
+    QCOMPARE(cachedBlocks(second), NUM_BLOCKS);
+
+    // Only the short last block of a third file still fits; the rest is read but not cached
+    std::string third;
+    std::unique_ptr<CachingRandomAccessFile> thirdFile = openAndFill(third);
+    QVERIFY(thirdFile);
+    QCOMPARE(cachedBlocks(first), NUM_BLOCKS);
+    QCOMPARE(cachedBlocks(second), NUM_BLOCKS);
+    QCOMPARE(cachedBlocks(third), 1);
+    QVERIFY(QFileInfo::exists(QString::fromStdString(third) + "/3"));
+    QVERIFY(CachingRandomAccessFile::cachedBytes() <= CachingRandomAccessFile::MAX_CACHE_SIZE);
+}
+
+void TestCachingRandomAccessFile::leastRecentlyUsedEvicted() {
+    // Files are closed in order, a little apart, so their last use orders them
+    std::string directories[3];
+    for (std::string &directory : directories) {
+        QVERIFY(openAndFill(directory));
+        QTest::qWait(20);
+    }
+
+    // Room for the third file came from the older files, least recently used first
+    QVERIFY(!QFileInfo::exists(QString::fromStdString(directories[0])));
+    QCOMPARE(cachedBlocks(directories[1]), NUM_BLOCKS);
+    QCOMPARE(cachedBlocks(directories[2]), NUM_BLOCKS);
+    QVERIFY(diskUsage() <= CachingRandomAccessFile::MAX_CACHE_SIZE);
+    QVERIFY(CachingRandomAccessFile::cachedBytes() <= CachingRandomAccessFile::MAX_CACHE_SIZE);
+}
+
+QTEST_GUILESS_MAIN(TestCachingRandomAccessFile)
+#include "tst_cachingrandomaccessfile.moc"
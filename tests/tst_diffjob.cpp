@@ -0,0 +1,167 @@
+#include "DiffJob.h"
+#include "ParquetTableModel.h"
+
+// Undefine 'signals' macro from Qt to prevent conflict with arrow headers
+#undef signals
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <parquet/arrow/writer.h>
+
+#include <QDeadlineTimer>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class TestDiffJob : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void filesWithoutRowGroups();
+    void filesWithOnlyEmptyRowGroup();
+    void trailingEmptyRowGroup_data();
+    void trailingEmptyRowGroup();
+
+private:
+    static constexpr qint64 BLOCK = DiffJob::DIFF_BLOCK_ROWS;
+
+    // Writes rows 0..numRows-1 in row groups of rowGroupRows rows, then emptyRowGroups empty row
+    // groups. The value of changedRow, if any, differs from the other files.
+    QString writeFile(qint64 numRows, qint64 rowGroupRows, int emptyRowGroups, qint64 changedRow = -1);
+    QVector<DiffRegion> diff(const QString &leftPath, const QString &rightPath);
+
+    QTemporaryDir m_tempDir;
+    int m_files = 0;
+};
+
+void TestDiffJob::initTestCase() {
+    QVERIFY(m_tempDir.isValid());
+}
+
+QString TestDiffJob::writeFile(qint64 numRows, qint64 rowGroupRows, int emptyRowGroups, qint64 changedRow) {
+    auto schema = arrow::schema({arrow::field("id", arrow::int64()), arrow::field("value", arrow::utf8())});
+
+    arrow::Int64Builder ids;
+    arrow::StringBuilder values;
+    for (qint64 row = 0; row < numRows; ++row) {
+        if (!ids.Append(row).ok() || !values.Append(row == changedRow ? "changed" : std::to_string(row)).ok()) {
+            return QString();
+        }
+    }
+    std::shared_ptr<arrow::Array> idArray;
+    std::shared_ptr<arrow::Array> valueArray;
+    if (!ids.Finish(&idArray).ok() || !values.Finish(&valueArray).ok()) {
+        return QString();
+    }
+    auto table = arrow::Table::Make(schema, {idArray, valueArray});
+
+    const QString path = m_tempDir.filePath(QString("file-%1.parquet").arg(++m_files));
+    auto sink = arrow::io::FileOutputStream::Open(path.toStdString());
+    if (!sink.ok()) {
+        return QString();
+    }
+    auto writer = parquet::arrow::FileWriter::Open(*schema, arrow::default_memory_pool(), *sink);
+    if (!writer.ok()) {
+        return QString();
+    }
+    if (numRows > 0 && !(*writer)->WriteTable(*table, rowGroupRows).ok()) {
+        return QString();
+    }
+    // Writing a table without rows appends one empty row group
+    auto empty = table->Slice(0, 0);
+    for (int i = 0; i < emptyRowGroups; ++i) {
+        if (!(*writer)->WriteTable(*empty, rowGroupRows).ok()) {
+            return QString();
+        }
+    }
+    if (!(*writer)->Close().ok() || !(*sink)->Close().ok()) {
+        return QString();
+    }
+    return path;
+}
+
+QVector<DiffRegion> TestDiffJob::diff(const QString &leftPath, const QString &rightPath) {
+    ParquetTableModel left;
+    ParquetTableModel right;
+    if (!left.loadParquetFile(leftPath) || !right.loadParquetFile(rightPath)) {
+        qWarning() << "Could not load" << leftPath << rightPath;
+        return {DiffRegion()};
+    }
+
+    // The job signals from its pool threads, or from start() itself when there is nothing to read
+    DiffJob job(&left, &right, {"id", "value"});
+    std::atomic<bool> done(false);
+    QString error;
+    connect(&job, &DiffJob::finished, [&done]() { done = true; });
+    connect(&job, &DiffJob::failed, [&done, &error](const QString &message) {
+        error = message;
+        done = true;
+    });
+    job.start();
+
+    QDeadlineTimer deadline(30000);
+    while (!done && !deadline.hasExpired()) {
+        QTest::qWait(10);
+    }
+    if (!done || !error.isEmpty()) {
+        qWarning() << "Diff did not finish:" << error;
+        return {DiffRegion()};
+    }
+    return job.regions();
+}
+
+void TestDiffJob::filesWithoutRowGroups() {
+    const QString left = writeFile(0, BLOCK, 0);
+    const QString right = writeFile(0, BLOCK, 0);
+    QVERIFY(!left.isEmpty() && !right.isEmpty());
+    QVERIFY(diff(left, right).isEmpty());
+}
+
+void TestDiffJob::filesWithOnlyEmptyRowGroup() {
+    const QString empty = writeFile(0, BLOCK, 1);
+    const QString none = writeFile(0, BLOCK, 0);
+    QVERIFY(!empty.isEmpty() && !none.isEmpty());
+    QVERIFY(diff(empty, empty).isEmpty());
+    QVERIFY(diff(empty, none).isEmpty());
+}
+
+void TestDiffJob::trailingEmptyRowGroup_data() {
+    QTest::addColumn<qint64>("numRows");
+    QTest::addColumn<qint64>("rowGroupRows");
+
+    // The empty row group starts where the last block ends, one past the blocks that exist
+    QTest::newRow("ends on block boundary") << BLOCK << BLOCK;
+    QTest::newRow("ends on later block boundary") << 2 * BLOCK << BLOCK / 2;
+    QTest::newRow("ends within block") << BLOCK + 1000 << BLOCK;
+}
+
+void TestDiffJob::trailingEmptyRowGroup() {
+    QFETCH(qint64, numRows);
+    QFETCH(qint64, rowGroupRows);
+
+    const QString plain = writeFile(numRows, rowGroupRows, 0);
+    const QString trailing = writeFile(numRows, rowGroupRows, 1);
+    const QString changed = writeFile(numRows, rowGroupRows, 1, numRows - 1);
+    QVERIFY(!plain.isEmpty() && !trailing.isEmpty() && !changed.isEmpty());
+
+    // Same layout on both sides, then different layouts
+    QVERIFY(diff(trailing, trailing).isEmpty());
+    QVERIFY(diff(plain, trailing).isEmpty());
+    QVERIFY(diff(trailing, plain).isEmpty());
+
+    QVector<DiffRegion> regions = diff(trailing, changed);
+    QCOMPARE(regions.size(), 1);
+    QCOMPARE(regions[0].columns, QStringList{"value"});
+    QVERIFY(regions[0].rowsResolved);
+    QCOMPARE(regions[0].rows, QVector<qint64>{numRows - 1});
+
+    regions = diff(plain, changed);
+    QCOMPARE(regions.size(), 1);
+    QCOMPARE(regions[0].rows, QVector<qint64>{numRows - 1});
+}
+
+QTEST_GUILESS_MAIN(TestDiffJob)
+#include "tst_diffjob.moc"